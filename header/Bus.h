@@ -0,0 +1,235 @@
+/*! \addtogroup Bus
+* This module provides the Request/Report dispatch bus of the Functional Level. The Executive Level uses it to call the functions of the Mast and the IR Camera modules.
+*
+* A Request contains a Command and its arguments, and a Report contains a status (OK or NOT_OK) and the return arguments.
+* Both have a fixed binary layout: a small header followed by the arguments encoded in the order of the parameters of the concerning function
+* (int as 32 bits, double as 64 bits, bool as 8 bits, string as a 32-bit length followed by its characters, structures field by field,
+* arrays as a 32-bit number of elements followed by the elements).
+*
+* Most calls fit in the BUS_ARG_SIZE bytes kept inside the Request and the Report. The larger ones (e.g. the reference list of GetRefList(), a page of GetRefPage(),
+* the report of Mast_GetReport(), a list of MAST_TARGET of Mast_RunCampaign()) use a large argument buffer: when the encoded arguments do not fit,
+* Bus_Put() (or the handler, for the return arguments) takes a large buffer from a second pool, and pargs points to it instead of args.
+*
+* The handlers are kept in a constant table indexed by BUS_COMMAND, which is built at compile time, so the dispatch is an array access.
+* The Requests, the Reports and the large buffers come from pools which are allocated by Bus_Init(), so a call does not allocate any memory.
+*
+* - Bus_Init(int size, int large, int large_size)
+* - Bus_Acquire(BUS_REQUEST **ppreq, BUS_REPORT **pprep)
+* - Bus_Call(BUS_REQUEST *preq, BUS_REPORT *prep)
+* - Bus_Release(BUS_REQUEST *preq, BUS_REPORT *prep)
+* - Bus_Benchmark(int number, BUS_BENCH *preport)
+*  @{
+*/
+
+
+/** Size of the arguments kept inside a Request or a Report, in byte; larger arguments use a large buffer */
+#define BUS_ARG_SIZE 256
+
+
+/** BUS_COMMAND
+
+* It defines the Commands of the bus. Each Command calls the function with the same name.
+*/
+
+enum BUS_COMMAND{
+	BUS_TURN_ON, /**< TurnOn() */
+	BUS_TURN_OFF, /**< TurnOff() */
+	BUS_RUN_TEST, /**< RunTest() */
+	BUS_SET_EXPOSURE, /**< SetExposure() */
+	BUS_SET_AVERAGE, /**< SetAverage() */
+	BUS_SET_FILTER, /**< SetFilter() */
+	BUS_CAPTURE, /**< Capture(unsigned long *psequence), the sequence number is returned in the Report */
+	BUS_SAVE, /**< Save() */
+	BUS_CAPTURE_SAVE, /**< CaptureSave() */
+	BUS_GET_IMAGE, /**< GetImage(string ref, unsigned long *psequence), the sequence number is returned in the Report */
+	BUS_GET_REF_LIST, /**< GetRefList() */
+	BUS_DELETE_IMAGE, /**< DeleteImage() */
+	BUS_DELETE_ALL, /**< DeleteAll() */
+	BUS_MAST_SET_MODE, /**< Mast_SetMode() */
+	BUS_MAST_GET_MODE, /**< Mast_GetMode() */
+	BUS_MAST_SELF_TEST, /**< Mast_SelfTest() */
+	BUS_MAST_GET_REPORT, /**< Mast_GetReport() */
+	BUS_MAST_HOME_JOINT, /**< Mast_HomeJoint() */
+	BUS_MAST_HOME_ALL_JOINTS, /**< Mast_HomeAllJoints() */
+	BUS_MAST_HALT_JOINT, /**< Mast_HaltJoint() */
+	BUS_MAST_HALT_ALL_JOINTS, /**< Mast_HaltAllJoints() */
+	BUS_MAST_RESET_JOINT, /**< Mast_ResetJoint() */
+	BUS_MAST_RESET_ALL_JOINTS, /**< Mast_ResetAllJoints() */
+	BUS_MAST_SET_BIN_POS, /**< Mast_SetBinPos() */
+	BUS_MAST_SET_JOINT_PARA, /**< Mast_SetJointPara() */
+	BUS_MAST_GET_JOINT_PARA, /**< Mast_GetJointPara() */
+	BUS_MAST_SET_JOINT_VALUE, /**< Mast_SetJointValue() */
+	BUS_MAST_GET_JOINT_VALUE, /**< Mast_GetJointValue() */
+	BUS_MAST_SET_JOINT_VALUES, /**< Mast_SetJointValues() */
+	BUS_MAST_GET_JOINT_VALUES, /**< Mast_GetJointValues() */
+	BUS_MAST_SET_END_EFFECTOR_POS, /**< Mast_SetEndEffectorPos() */
+	BUS_MAST_GET_END_EFFECTOR_POS, /**< Mast_GetEndEffectorPos() */
+	BUS_MAST_SAMPLE_RETRIEVE, /**< Mast_SampleRetrieve() */
+	BUS_MAST_SAMPLE_VERIFY, /**< Mast_SampleVerify() */
+	BUS_MAST_SAMPLE_DUMP, /**< Mast_SampleDump() */
+	BUS_MAST_GET_SAMPLE_COOR, /**< Mast_GetSampleCoor() */
+	BUS_MAST_FORWARD_SAMPLE_COOR, /**< Mast_ForwardSampleCoor() */
+	BUS_MAST_SET_MAST_ROOT_POSITION, /**< Mast_SetMastRootPosition() */
+	BUS_MAST_GET_HOME_CONFIG, /**< Mast_GetHomeConfig() */
+	BUS_MAST_SCOOP, /**< Mast_Scoop() */
+	BUS_MAST_DROP, /**< Mast_Drop() */
+	BUS_MAST_TURN_RIGHT, /**< Mast_TurnRight() */
+	BUS_MAST_TURN_LEFT, /**< Mast_TurnLeft() */
+	BUS_MAST_TURN_DOWN, /**< Mast_TurnDown() */
+	BUS_MAST_TURN_UP, /**< Mast_TurnUp() */
+	BUS_MAST_WAIT, /**< Mast_Wait() */
+	BUS_MAST_SET_MODE_ASYNC, /**< Mast_SetModeAsync() */
+	BUS_MAST_SET_JOINT_VALUE_ASYNC, /**< Mast_SetJointValueAsync() */
+	BUS_MAST_SET_JOINT_VALUES_ASYNC, /**< Mast_SetJointValuesAsync() */
+	BUS_MAST_SET_END_EFFECTOR_POS_ASYNC, /**< Mast_SetEndEffectorPosAsync() */
+	BUS_MAST_HOME_ALL_JOINTS_ASYNC, /**< Mast_HomeAllJointsAsync() */
+	BUS_MAST_HOME_JOINT_ASYNC, /**< Mast_HomeJointAsync() */
+	BUS_MAST_RESET_JOINT_ASYNC, /**< Mast_ResetJointAsync() */
+	BUS_MAST_RESET_ALL_JOINTS_ASYNC, /**< Mast_ResetAllJointsAsync() */
+	BUS_MAST_SCOOP_ASYNC, /**< Mast_ScoopAsync() */
+	BUS_MAST_DROP_ASYNC, /**< Mast_DropAsync() */
+	BUS_MAST_SAMPLE_RETRIEVE_ASYNC, /**< Mast_SampleRetrieveAsync() */
+	BUS_MAST_SAMPLE_DUMP_ASYNC, /**< Mast_SampleDumpAsync() */
+	BUS_ACQUIRE_FRAME, /**< AcquireFrame() */
+	BUS_CAPTURE_SAVE_ASYNC, /**< CaptureSaveAsync() */
+	BUS_CAPTURE_SEQUENCE, /**< CaptureSequence() */
+	BUS_GET_IMAGE_INFO, /**< GetImageInfo() */
+	BUS_GET_IMAGE_REGION, /**< GetImageRegion() */
+	BUS_GET_REF_PAGE, /**< GetRefPage() */
+	BUS_RECLAIM_STORE, /**< ReclaimStore() */
+	BUS_RELEASE_FRAME, /**< ReleaseFrame() */
+	BUS_RUN_AVERAGE_BENCHMARK, /**< RunAverageBenchmark() */
+	BUS_SAVE_ASYNC, /**< SaveAsync() */
+	BUS_SET_AVERAGE_KERNEL, /**< SetAverageKernel() */
+	BUS_SET_FRAME_RING, /**< SetFrameRing() */
+	BUS_SET_IMAGE_FORMAT, /**< SetImageFormat() */
+	BUS_SET_IMAGE_STORE, /**< SetImageStore() */
+	BUS_WAIT_SAVE, /**< WaitSave() */
+	BUS_MAST_BENCHMARK_IK, /**< Mast_BenchmarkIK() */
+	BUS_MAST_BUILD_MODE_TABLE, /**< Mast_BuildModeTable() */
+	BUS_MAST_GET_HALT_LATENCY, /**< Mast_GetHaltLatency() */
+	BUS_MAST_GET_MODE_PATH, /**< Mast_GetModePath() */
+	BUS_MAST_GET_MODE_SETPOINT, /**< Mast_GetModeSetpoint() */
+	BUS_MAST_GET_SETPOINT, /**< Mast_GetSetpoint() */
+	BUS_MAST_GET_STATE, /**< Mast_GetState() */
+	BUS_MAST_GET_TELEOP_LATENCY, /**< Mast_GetTeleopLatency() */
+	BUS_MAST_GET_TELEOP_TARGET, /**< Mast_GetTeleopTarget() */
+	BUS_MAST_PLAN_CAMPAIGN, /**< Mast_PlanCampaign() */
+	BUS_MAST_PLAN_TRAJECTORY, /**< Mast_PlanTrajectory() */
+	BUS_MAST_RUN_CAMPAIGN, /**< Mast_RunCampaign() */
+	BUS_MAST_SAMPLE_VERIFY_FRAMES, /**< Mast_SampleVerifyFrames() */
+	BUS_MAST_SET_CONTROL_RATE, /**< Mast_SetControlRate() */
+	BUS_MAST_SET_HALT_DEADLINE, /**< Mast_SetHaltDeadline() */
+	BUS_MAST_SET_IK_CACHE, /**< Mast_SetIKCache() */
+	BUS_MAST_SET_OBSTACLE, /**< Mast_SetObstacle() */
+	BUS_MAST_SET_VERIFY_PARA, /**< Mast_SetVerifyPara() */
+	BUS_MAST_SOLVE_FK, /**< Mast_SolveFK() */
+	BUS_MAST_SOLVE_IK, /**< Mast_SolveIK() */
+	BUS_MAST_START_CONTROL_LOOP, /**< Mast_StartControlLoop() */
+	BUS_MAST_STOP_CONTROL_LOOP, /**< Mast_StopControlLoop() */
+	BUS_COMMANDS /**< Number of Commands */
+	
+}; 
+
+
+/** Bus Request
+
+* It includes a Command and its arguments.
+*/
+
+typedef struct 
+{
+	unsigned short command ; /**< BUS_COMMAND */ 
+	unsigned int length ; /**< Length of the encoded arguments, in byte */ 
+	unsigned int id ; /**< Request ID, it is copied in the Report */ 
+	unsigned char *pargs ; /**< Encoded arguments: args, or a large buffer when length is greater than BUS_ARG_SIZE */ 
+	unsigned char args[BUS_ARG_SIZE] ; /**< Encoded arguments which fit in the Request */ 
+} BUS_REQUEST;
+
+
+/** Bus Report
+
+* It includes OK or NOT_OK and the return arguments of a Request.
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< STATUS returned by the function */ 
+	unsigned short command ; /**< BUS_COMMAND of the Request */ 
+	unsigned int length ; /**< Length of the encoded return arguments, in byte */ 
+	unsigned int id ; /**< Request ID */ 
+	unsigned char *pargs ; /**< Encoded return arguments: args, or a large buffer when length is greater than BUS_ARG_SIZE */ 
+	unsigned char args[BUS_ARG_SIZE] ; /**< Encoded return arguments which fit in the Report */ 
+} BUS_REPORT;
+
+
+/** Bus Benchmark Report
+
+* It includes the result of Bus_Benchmark().
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< OK or NOT_OK  */ 
+	int number ; /**< Number of round trips */ 
+	double round_trips_per_second ; /**< Number of Request/Report round trips per second */ 
+	double p99 ; /**< 99th percentile latency of one round trip, in microsecond */ 
+	int allocations ; /**< Number of heap allocations during the benchmark, it should be 0 */ 
+} BUS_BENCH;
+
+
+
+/** It initializes the bus and allocates the pool of Requests and Reports, and the pool of large argument buffers.
+* @param size : number of Request/Report pairs in the pool
+* @param large : number of large argument buffers in the pool
+* @param large_size : size of a large argument buffer, in byte; it limits the size of the encoded arguments of a call
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Bus_Init(int size, int large, int large_size);
+
+/** It takes a Request and a Report from the pool.
+* @param **ppreq : Request
+* @param **pprep : Report
+* @return  Code of the first error encountered (e.g. the pool is empty), otherwise OK 
+*/
+STATUS Bus_Acquire(BUS_REQUEST **ppreq, BUS_REPORT **pprep);
+
+/** It gives back a Request and a Report to the pool, with their large argument buffers.
+* @param *preq : Request
+* @param *prep : Report
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Bus_Release(BUS_REQUEST *preq, BUS_REPORT *prep);
+
+/** It dispatches a Request to the handler of its Command and fills the Report.
+* @param *preq : Request
+* @param *prep : Report
+* @return  Code of the first error encountered in the dispatch (e.g. unknown Command, wrong length), otherwise OK. The STATUS of the function is in the Report.
+*/
+STATUS Bus_Call(BUS_REQUEST *preq, BUS_REPORT *prep);
+
+/** It appends an argument to the encoded arguments of a Request. When the arguments do not fit in args anymore, they are moved to a large argument buffer.
+* @param *preq : Request
+* @param *pvalue : argument
+* @param size : size of the argument, in byte
+* @return  Code of the first error encountered (e.g. the size of a large buffer is exceeded, no large buffer is left in the pool), otherwise OK 
+*/
+STATUS Bus_Put(BUS_REQUEST *preq, const void *pvalue, int size);
+
+/** It reads a return argument from the encoded arguments of a Report.
+* @param *prep : Report
+* @param offset : offset of the argument in the encoded arguments, in byte
+* @param *pvalue : argument
+* @param size : size of the argument, in byte
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Bus_Get(BUS_REPORT *prep, int offset, void *pvalue, int size);
+
+/** It sends Requests to the Mast and IR Camera modules (query Commands only, nothing moves) and measures the round trips.
+* @param number : number of round trips
+* @param *preport : benchmark report
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Bus_Benchmark(int number, BUS_BENCH *preport);
+
+/*! @} */
@@ -0,0 +1,129 @@
+/*! \addtogroup Executive
+* This module provides the state machine engine of the Executive Control Level. It runs the scripts which call the Requests of the Functional Level modules.
+*
+* A script defines a set of states. Each state has a list of steps and a list of transitions:
+*
+* - A step is a Request of the Bus module (a BUS_COMMAND and its arguments). The steps of a state run in order, except the steps of a \b parallel group,
+* which run concurrently (e.g. IR Capture() while the mast moves to a bin by Mast_SampleDump()). In a parallel group, a mast motion is compiled into its asynchronous
+* Command (e.g. BUS_MAST_SAMPLE_DUMP_ASYNC) and the group ends with a BUS_MAST_WAIT for each of them, so the group ends when all its steps are finished.
+* - A transition gives the next state according to the result of the state (OK, NOT_OK or a specific error code) or the success flag of Mast_SampleVerify().
+*
+* The result of a step is the STATUS of its function. The result of a parallel group is the first result which is not OK among its members, in the order of the group,
+* where the result of a mast motion is the STATUS of the motion returned in *presult by its BUS_MAST_WAIT (not the STATUS of Mast_Wait() itself); it is OK if all the members succeed.
+* The steps of a state stop at the first step or group whose result is not OK, and that result is the result of the state; otherwise the result of the state is OK.
+*
+* \section exec_syntax Script definition
+*
+* A script definition is a text file with one statement per line. Blank lines and the lines starting with # are ignored.
+*
+* - <tt>state NAME</tt> starts a state. The first state of the file is the initial state.
+* - <tt>FUNCTION ARG ...</tt> is a step. FUNCTION is the name of a function of the Bus Commands (e.g. <tt>Mast_SampleDump 2</tt>), and the arguments are written as follows:
+*   - a number, a quoted string, an enum value by its name (e.g. \c ACTIVE), or a variable written <tt>$VAR</tt>;
+*   - a structure as its fields in braces, in the order of the declaration, e.g. END_EFFECTOR_POS <tt>{0.4, 0.1, -0.2, 0.5}</tt>;
+*   a field which is an array is written as its elements, e.g. MAST_CONFIG <tt>{0.0, 0.7, -1.2, 0.3}</tt>;
+*   - an array (e.g. <tt>CAPTURE_STEP steps[]</tt> or <tt>MAST_TARGET targets[]</tt>) as its elements in square brackets, e.g. <tt>[{0, 100, 4}, {3, 250, 8}]</tt>;
+*   the number of elements is given by the brackets, so the following count parameter (e.g. \c number) is not written.
+* - <tt>VAR = FUNCTION ARG ...</tt> is a step whose first return argument is kept in the variable VAR (e.g. <tt>img1 = CaptureSave</tt>).
+* - <tt>parallel</tt> and <tt>end</tt> enclose a parallel group. A group cannot contain another group or two motions of the mast.
+* - <tt>on RESULT goto NAME</tt> is a transition, where RESULT is OK, NOT_OK, an error code, \c success or \c failure (flag of Mast_SampleVerify()), or \c any.
+* The transitions are checked in order, after the last step of the state.
+* - <tt>final</tt> makes the state a final state: the script ends after its steps.
+*
+* For example:
+*
+* <pre>
+* state dump
+*     parallel
+*         Mast_SampleDump 2
+*         img1 = CaptureSave
+*     end
+*     stack = CaptureSequence [{0, 100, 4}, {3, 250, 8}]
+*     on OK goto done
+*     on any goto failed
+* state done
+*     final
+* state failed
+*     Mast_HomeAllJoints
+*     final
+* </pre>
+*
+* Exec_Load() reads the script definition and compiles it once into a flat table of encoded Requests and a transition table indexed by state and STATUS.
+* Running a compiled script does not parse or allocate anything, so the overhead per transition is a few microseconds.
+*
+* - Exec_Load(string path, int *pscript)
+* - Exec_Compile(string definition, int *pscript)
+* - Exec_ReplaceStates(int script, string definition)
+* - Exec_Run(int script, string state, EXEC_REPORT *preport)
+* - Exec_Stop(int script)
+* - Exec_GetState(int script, string *pstate)
+*  @{
+*/
+
+
+/** Executive Report
+
+* It includes the result of a script run by Exec_Run().
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< STATUS of the last step */ 
+	int steps ; /**< Number of executed steps */ 
+	int transitions ; /**< Number of executed transitions */ 
+	double duration ; /**< Duration of the run, in ms */ 
+	double overhead ; /**< Time spent in the engine (not in the steps), in ms */ 
+} EXEC_REPORT;
+
+
+
+/** It loads a script definition and compiles it.
+* @param path : Path of the script definition
+* @param *pscript : script ID
+* @return  Code of the first error encountered (e.g. a statement which does not follow the script definition, unknown Command, state or variable), otherwise OK 
+*/
+STATUS Exec_Load(string path, int *pscript);
+
+/** It compiles a script definition given as a string (e.g. a script generated by the Mission module).
+* @param definition : script definition
+* @param *pscript : script ID
+* @return  Code of the first error encountered (e.g. a statement which does not follow the script definition, unknown Command, state or variable), otherwise OK 
+*/
+STATUS Exec_Compile(string definition, int *pscript);
+
+/** It compiles a set of states given as a script definition and replaces the states with the same names in a compiled script. The new states are added.
+* The other states keep their compiled Requests and transitions, so only the given states are compiled. The script should not be running.
+* @param script : script ID
+* @param definition : script definition of the replaced and the new states
+* @return  Code of the first error encountered (e.g. the script is running, a statement which does not follow the script definition, a transition to an unknown state), otherwise OK 
+*/
+STATUS Exec_ReplaceStates(int script, string definition);
+
+/** It unloads a compiled script.
+* @param script : script ID
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Exec_Unload(int script);
+
+/** It runs a compiled script until it reaches a final state or it is stopped.
+* @param script : script ID
+* @param state : name of the initial state, empty string for the first state of the script
+* @param *preport : executive report
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Exec_Run(int script, string state, EXEC_REPORT *preport);
+
+/** It stops a running script. The running steps are finished and no transition is executed.
+Note: It does not halt the mast. Mast_HaltAllJoints() should be called for an emergency stop.
+* @param script : script ID
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Exec_Stop(int script);
+
+/** It returns the current state of a script.
+* @param script : script ID
+* @param *pstate : name of the current state
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Exec_GetState(int script, string *pstate);
+
+/*! @} */
@@ -0,0 +1,93 @@
+/*! \addtogroup Housekeeping
+* This module provides the power and thermal scheduler of the Mast and the IR Camera workloads, driven by the housekeeping reports.
+*
+* The housekeeping feed gives the system mode (Off, Active or Sleep), the temperatures and the available power. Until the link with the House Keeping Machine is defined,
+* a local stand-in feed is used: the reports are pushed by HK_PushReport() or read from a file by HK_SetFeedFile().
+*
+* The scheduler estimates the power of each workload from the power model of HK_BUDGET: for the mast trajectories, the motor bus voltage times the sum of the joint currents
+* (bounded by curr_max of JOINT_PARA) plus the holding power; for the IR capture and averaging, the camera power.
+* The workloads are overlapped when the sum fits in the power and thermal budget. Otherwise they are throttled smoothly: the trajectories are slowed down
+* (lower velocity and acceleration) and the captures are delayed, instead of returning an error.
+* When the mast is in NAVIGATION or STOWAGE mode, the scheduler puts it in the minimum energy holding state automatically.
+*
+* - HK_SetBudget(HK_BUDGET budget)
+* - HK_PushReport(HK_REPORT report)
+* - HK_SetFeedFile(string path)
+* - HK_GetThrottle(double *pmast, double *pcamera)
+*  @{
+*/
+
+
+/** HK_MODE
+
+* It defined the system mode given by the House Keeping Machine.
+*/
+
+enum HK_MODE{
+	HK_OFF, /**< Off Mode */
+	HK_ACTIVE, /**< Active Mode */
+	HK_SLEEP /**< Sleep Mode */
+	
+}; 
+
+
+/** Housekeeping Report
+
+* It includes the system mode, the temperature report and the power report.
+*/
+
+typedef struct 
+{
+	double time ; /**< Time of the report, in second */ 
+	enum HK_MODE mode ; /**< System mode */ 
+	double temperature_mast ; /**< Temperature of the mast motors, in degree Celsius */ 
+	double temperature_camera ; /**< Temperature of the IR Camera, in degree Celsius */ 
+	double power_available ; /**< Power available for the Functional Level, in watt */ 
+} HK_REPORT;
+
+
+/** Housekeeping Budget
+
+* It defines the limits respected by the scheduler.
+*/
+
+typedef struct 
+{
+	double power_max ; /**< Maximum power of the mast and the camera together, in watt */ 
+	double motor_voltage ; /**< Voltage of the motor bus of the mast, in volt (joint power = motor_voltage x joint current) */ 
+	double mast_holding ; /**< Power of the mast when it holds its configuration without moving, in watt */ 
+	double camera_power ; /**< Power of the IR Camera during capture and averaging, in watt */ 
+	double temperature_mast_max ; /**< Maximum temperature of the mast motors, in degree Celsius */ 
+	double temperature_camera_max ; /**< Maximum temperature of the IR Camera, in degree Celsius */ 
+	double margin ; /**< Temperature margin in degree Celsius below the maximum, where the throttling starts */ 
+} HK_BUDGET;
+
+
+
+/** It sets the power and thermal budget.
+* @param budget : budget
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS HK_SetBudget(HK_BUDGET budget);
+
+/** It gives a housekeeping report to the scheduler (local stand-in feed).
+Note: In Sleep Mode or Off Mode, the running workloads are finished and no new workload is started.
+* @param report : housekeeping report
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS HK_PushReport(HK_REPORT report);
+
+/** It reads the housekeeping reports from a file (local stand-in feed), one report per line, in the order of their time.
+* @param path : Path of the file
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS HK_SetFeedFile(string path);
+
+/** It returns the current throttling of the workloads.
+* @param *pmast : ratio of the mast velocity and acceleration limits which is used, 1 for no throttling
+* @param *pcamera : ratio of the camera capture rate which is used, 1 for no throttling
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS HK_GetThrottle(double *pmast, double *pcamera);
+
+/*! @} */
@@ -12,7 +12,54 @@
 *
 * - TurnOff()
 *
-* The module has a shrared memory to keep the captured image and share it with any other module.
+* The module has a shared memory to keep the captured images and share them with any other module.
+*
+* The shared memory is a ring of frame slots (POSIX shared memory). Each Capture() writes the next free slot and gets a new sequence number,
+* so the camera can capture back to back without waiting for the previous reader. The sequence number of the new frame is returned by
+* Capture(unsigned long *psequence), GetImage(string ref, unsigned long *psequence) and GetImageRegion(). A slot is reference counted:
+* any module (e.g. Mast_SampleVerify) can map a frame by AcquireFrame() without copying it, and should call ReleaseFrame() when it is done.
+* A slot which is still acquired by a reader is never overwritten.
+*
+* - SetFrameRing(int slots)
+* - Capture(unsigned long *psequence)
+* - AcquireFrame(unsigned long sequence, IR_FRAME *pframe)
+* - ReleaseFrame(IR_FRAME *pframe)
+*
+* The saved images are kept in an append-only image store which is memory mapped, with an index file.
+* A background writer thread appends the frames to the store in batches, so Save() and CaptureSave() do not wait for the disk.
+* SaveAsync() and CaptureSaveAsync() return the reference right away with a ticket, and WaitSave() waits until the image is persisted.
+* GetImage() and GetRefList() read the references directly from the mapped index.
+*
+* - SetImageStore(string path, int batch)
+* - SaveAsync(unsigned long sequence, string *pref, SAVE_TICKET *pticket)
+* - CaptureSaveAsync(string *pref, SAVE_TICKET *pticket)
+* - WaitSave(SAVE_TICKET ticket, int timeout)
+*
+* The references are kept in a persistent catalog next to the image store: a hash map from the reference to the offset of the image in the store,
+* and sorted indexes on filter_id, exposure and timestamp. So GetImage() and DeleteImage() do not scan the stored images,
+* and GetRefPage() returns a filtered list page by page. DeleteAll() only starts a new generation of the catalog;
+* the images of the previous generations are reclaimed later by the writer thread or by ReclaimStore().
+*
+* - GetImageInfo(string ref, IMAGE_INFO *pinfo)
+* - GetRefPage(IMAGE_QUERY query, int cursor, int count, string *preflist, int *pnext)
+* - ReclaimStore(int number)
+*
+* A spectral sweep is captured by CaptureSequence() with a list of (filter, exposure, averages) steps. The move of the filter wheel to the next filter starts
+* as soon as the exposures of a step are finished, and it overlaps the averaging and the saving of that step. The frames of all steps are saved as one multi-band image stack.
+* So a sweep takes close to the sum of the exposure times.
+*
+* A band of a stack is referenced by the reference of the stack followed by ':' and the band index (e.g. "ref:3"). The reference of the stack alone means band 0.
+* GetImage() and GetImageRegion() accept band references. The catalog has one entry per band, indexed by the filter_id and the exposure of the band,
+* so GetRefPage() returns band references; GetImageInfo() gives the band index and the number of bands. DeleteImage() of a stack reference deletes all its bands.
+*
+* - CaptureSequence(CAPTURE_STEP steps[], int number, string *pref, SEQUENCE_REPORT *preport)
+*
+* The images can be saved in a tiled format. The image is split in square tiles, and each tile is compressed without loss by a fast integer codec
+* (prediction from the left and upper pixels, then bit packing of the residuals). The header of the image has the index of the tiles (offset, size and CRC32C checksum of each tile).
+* GetImageRegion() decodes only the tiles of a region of interest, in parallel, and checks their checksums.
+*
+* - SetImageFormat(enum IMAGE_FORMAT format, int tile)
+* - GetImageRegion(string ref, int x, int y, int width, int height)
 *  @{
 */
 
@@ -36,6 +83,146 @@ typedef struct
 } CAMERA_IR_TEST;
 
 
+/** IR Frame
+
+* It describes a frame which is kept in one slot of the shared memory frame ring.
+* The pixel data is mapped from the shared memory and should not be modified by the readers.
+*/
+
+typedef struct 
+{
+	unsigned long sequence ; /**< Sequence number of the frame, it increases by one for each new frame */ 
+	int slot ; /**< Slot of the frame in the frame ring */ 
+	int width ; /**< Image width in pixel */ 
+	int height ; /**< Image height in pixel */ 
+	int x0 ; /**< x of the top left corner of the frame in the full image, in pixel; 0 except for a region loaded by GetImageRegion() */ 
+	int y0 ; /**< y of the top left corner of the frame in the full image, in pixel; 0 except for a region loaded by GetImageRegion() */ 
+	int filter_id ; /**< IR filter used for the capture */ 
+	int exposure ; /**< Exposure time in ms */ 
+	const unsigned short *pixels ; /**< Pixel data (read only), mapped from the shared memory */ 
+} IR_FRAME;
+
+
+/** Maximum number of images averaged by SetAverage().
+
+* The 32-bit running sum of 16-bit frames cannot overflow up to this depth (65537 x 65535 = 2^32 - 1).
+*/
+
+#define AVERAGE_MAX 65537
+
+
+/** AVERAGE_KERNEL
+
+* It defines the kernel used to accumulate the 16-bit frames in the 32-bit running sum of SetAverage().
+*/
+
+enum AVERAGE_KERNEL{
+	KERNEL_AUTO, /**< The best kernel supported by the processor */
+	KERNEL_SCALAR, /**< Portable scalar kernel */
+	KERNEL_AVX2, /**< AVX2 kernel (x86) */
+	KERNEL_NEON /**< NEON kernel (ARM) */
+	
+}; 
+
+
+/** Averaging Benchmark Report
+
+* It includes the result of RunAverageBenchmark() on synthetic frames.
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< OK or NOT_OK  */ 
+	enum AVERAGE_KERNEL kernel ; /**< Kernel used for the benchmark */ 
+	int number ; /**< Averaging depth (number of frames) */ 
+	double accumulate_time ; /**< Mean time to add one frame to the running sum, in ms */ 
+	double finish_time ; /**< Time from the last frame to the averaged image, in ms */ 
+	double total_time ; /**< Time from the first frame to the averaged image, in ms */ 
+} AVERAGE_BENCH;
+
+
+/** Save Ticket
+
+* It is returned by SaveAsync() and CaptureSaveAsync() and it is used by WaitSave() to wait until the image is persisted.
+*/
+
+typedef unsigned long SAVE_TICKET;
+
+
+/** Image Information
+
+* It is the catalog entry of a saved image.
+*/
+
+typedef struct 
+{
+	unsigned long offset ; /**< Offset of the image in the image store */ 
+	unsigned long size ; /**< Size of the image in the image store, in byte */ 
+	unsigned long generation ; /**< Catalog generation of the image */ 
+	double timestamp ; /**< Capture time in second */ 
+	int filter_id ; /**< IR filter used for the capture */ 
+	int exposure ; /**< Exposure time in ms */ 
+	int average ; /**< Number of averaged images */ 
+	int band ; /**< Band index in its stack, 0 for a single image */ 
+	int bands ; /**< Number of bands of its stack, 1 for a single image */ 
+} IMAGE_INFO;
+
+
+/** Image Query
+
+* It defines the filter used by GetRefPage(). A negative value disables the concerning criterion.
+*/
+
+typedef struct 
+{
+	int filter_id ; /**< IR filter, -1 for any filter */ 
+	int exposure_min ; /**< Minimum exposure time in ms */ 
+	int exposure_max ; /**< Maximum exposure time in ms */ 
+	double time_min ; /**< Minimum capture time in second */ 
+	double time_max ; /**< Maximum capture time in second */ 
+} IMAGE_QUERY;
+
+
+/** Capture Step
+
+* It defines one band of a capture sequence.
+*/
+
+typedef struct 
+{
+	int filter_id ; /**< IR filter, between 0 and 7 */ 
+	int exposure ; /**< Exposure time in ms */ 
+	int average ; /**< Number of averaged images */ 
+} CAPTURE_STEP;
+
+
+/** Sequence Report
+
+* It includes the timing of CaptureSequence().
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< OK or NOT_OK  */ 
+	int bands ; /**< Number of bands in the image stack */ 
+	double exposure_time ; /**< Sum of the exposure times, in ms */ 
+	double filter_wait ; /**< Time spent waiting for the filter wheel, in ms */ 
+	double duration ; /**< Duration of the sequence, in ms */ 
+} SEQUENCE_REPORT;
+
+
+/** IMAGE_FORMAT
+
+* It defines the format of the saved images.
+*/
+
+enum IMAGE_FORMAT{
+	FORMAT_RAW, /**< Uncompressed image */
+	FORMAT_TILED /**< Tiled image, each tile is compressed without loss */
+	
+}; 
+
+
 
 /** It turns the camera on.
 * @return  Code of the first error encountered, otherwise OK 
@@ -62,53 +249,227 @@ CAMERA_IR_TEST RunTest();
 STATUS SetExposure(int time);
 
 /** It sets the number of images that should be captured.
-* @param number : number of images
-* @return  Code of the first error encountered, otherwise OK 
+
+Note: The images are averaged as a stream. Each frame is added to a 32-bit running sum as soon as it arrives,
+and a single normalization pass is done after the last frame. So the averaged image is ready within one frame time of the last exposure.
+The averaged image becomes accessible in the shared memory as one frame.
+
+* @param number : number of images, between 1 and AVERAGE_MAX
+* @return  Code of the first error encountered (e.g. number is greater than AVERAGE_MAX), otherwise OK 
 */
 STATUS SetAverage(int number);
 
+/** It selects the kernel used to accumulate the frames in SetAverage().
+* @param kernel : AVERAGE_KERNEL, KERNEL_AUTO by default
+* @return  Code of the first error encountered (e.g. the kernel is not supported by the processor), otherwise OK 
+*/
+STATUS SetAverageKernel(enum AVERAGE_KERNEL kernel);
+
+/** It runs the averaging on synthetic frames, without using the camera, and returns the timing. 
+It should be called for several averaging depths to compare them.
+* @param number : averaging depth (number of frames), between 1 and AVERAGE_MAX
+* @param width : Image width in pixel
+* @param height : Image height in pixel
+* @param *preport : benchmark report
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS RunAverageBenchmark(int number, int width, int height, AVERAGE_BENCH *preport);
+
 
 /** It Sets IR filter to the defined filter ID.
 
+Note: It starts the move of the filter wheel and returns. Capture() waits for the end of the move.
+
 * @param filter_id : It can be an integer between 0 and 7
 * @return  Code of the first error encountered, otherwise OK 
 */
  STATUS SetFilter(Int filter_id);
 
+/** It captures a sequence of bands and saves them as one multi-band image stack.
+The move of the filter wheel to the next band overlaps the averaging and the saving of the previous band.
+Note: The exposure, the average and the filter set by SetExposure(), SetAverage() and SetFilter() are restored at the end.
+
+* @param steps : list of bands
+* @param number : number of bands
+* @param *pref : A reference to the saved image stack
+* @param *preport : sequence report
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS CaptureSequence(CAPTURE_STEP steps[], int number, string *pref, SEQUENCE_REPORT *preport);
+
+/** It sets the number of slots of the shared memory frame ring.
+
+Note: It should be called before TurnOn(). The default is 8 slots.
+
+* @param slots : number of slots, at least 2
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS SetFrameRing(int slots);
+
 /** It captures an image. Image will become accessible in a shared memory. 
+
+Note: The image is written in the oldest slot of the frame ring which is not acquired by any reader. Capture() does not wait for the readers of the previous frames.
+Note: An error is returned if all slots are acquired by the readers.
+
 * @return  Code of the first error encountered, otherwise OK 
 */
 STATUS Capture();
 
-/** It saves the captured image available in the shared memory.
+/** It captures an image and returns the sequence number of its frame. Image will become accessible in a shared memory. 
+
+Note: It should be used instead of Capture() when other captures can run at the same time (e.g. in a parallel group of an executive script),
+because the last frame may then be the frame of another capture.
+
+* @param *psequence : Sequence number of the captured frame
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Capture(unsigned long *psequence);
+
+/** It maps a frame of the shared memory without copying it and increases the reference count of its slot.
+* The slot will not be overwritten before ReleaseFrame() is called.
+* @param sequence : Sequence number of the frame returned by Capture(), GetImage() or GetImageRegion(); 0 for the last frame, only when no other capture can run at the same time
+* @param *pframe : frame
+* @return  Code of the first error encountered (e.g. the frame has already been overwritten), otherwise OK 
+*/
+STATUS AcquireFrame(unsigned long sequence, IR_FRAME *pframe);
+
+/** It releases a frame acquired by AcquireFrame() and decreases the reference count of its slot.
+* @param *pframe : frame
 * @return  Code of the first error encountered, otherwise OK 
 */
+STATUS ReleaseFrame(IR_FRAME *pframe);
+
+/** It sets the image store used to save the images.
+
+Note: It should be called before TurnOn(). The store and its index file are created if they do not exist.
+
+* @param path : Path of the image store, the index file is path + ".idx"
+* @param batch : Maximum number of images written by the writer thread in one batch
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS SetImageStore(string path, int batch);
+
+/** It sets the format of the images saved after this call. The images which are already saved keep their format.
+* @param format : IMAGE_FORMAT, FORMAT_TILED by default
+* @param tile : Tile size in pixel (square tiles), it is used by FORMAT_TILED
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS SetImageFormat(enum IMAGE_FORMAT format, int tile);
+
+/** It saves the captured image available in the shared memory.
+
+Note: It is the same as SaveAsync() of the last frame followed by WaitSave().
+
+* @return  A reference to the saved image 
+*/
 string Save();
 
 /** It captures an image.
+
+Note: It is the same as CaptureSaveAsync() followed by WaitSave().
+
 * @return  A reference to the saved image 
 */
 string CaptureSave();
 
+/** It queues a frame of the shared memory to the writer thread and returns without waiting for the disk.
+* The image remains accessible by its reference before it is persisted.
+* @param sequence : Sequence number of the frame to save, returned by Capture()
+* @param *pref : A reference to the saved image
+* @param *pticket : ticket to wait for the image to be persisted
+* @return  Code of the first error encountered (e.g. the image store is not set, the queue of the writer thread is full), otherwise OK 
+*/
+STATUS SaveAsync(unsigned long sequence, string *pref, SAVE_TICKET *pticket);
+
+/** It captures an image and queues the frame of this capture to the writer thread without waiting for the disk.
+* @param *pref : A reference to the saved image
+* @param *pticket : ticket to wait for the image to be persisted
+* @return  Code of the first error encountered (e.g. capture error, the image store is not set, the queue of the writer thread is full), otherwise OK 
+*/
+STATUS CaptureSaveAsync(string *pref, SAVE_TICKET *pticket);
+
+/** It waits until an image queued by SaveAsync() or CaptureSaveAsync() is persisted in the image store.
+* @param ticket : ticket returned by SaveAsync() or CaptureSaveAsync()
+* @param timeout : Timeout in ms, 0 to return immediately, -1 to wait without timeout
+* @return  OK if the image is persisted, otherwise error code (e.g. timeout, disk error)
+*/
+STATUS WaitSave(SAVE_TICKET ticket, int timeout);
+
 /** It returns a referenced image. Image will become accessible in a shared memory. 
+
+Note: The image is loaded in a slot of the frame ring as a new frame, so it can be mapped by AcquireFrame(0, pframe).
+Note: The reference is resolved from the mapped index of the image store.
+
 * @param ref : A reference to the name of the saved image
 * @return  status  
 */
 STATUS GetImage(string ref);
 
+/** It returns a referenced image and the sequence number of its frame. Image will become accessible in a shared memory. 
+* @param ref : A reference to the name of the saved image
+* @param *psequence : Sequence number of the frame, to be used by AcquireFrame()
+* @return  status  
+*/
+STATUS GetImage(string ref, unsigned long *psequence);
+
+/** It returns a region of a referenced image. Only the tiles of the region are read and decoded, in parallel. The region will become accessible in a shared memory as a frame.
+Note: The x0 and y0 of the frame are set to the top left corner of the region, so the pixel (i, j) of the frame is the pixel (x0 + i, y0 + j) of the full image.
+Note: For an image in FORMAT_RAW, the whole image is read.
+* @param ref : A reference to the name of the saved image
+* @param x : x of the top left corner of the region, in pixel
+* @param y : y of the top left corner of the region, in pixel
+* @param width : width of the region, in pixel
+* @param height : height of the region, in pixel
+* @param *psequence : Sequence number of the frame of the region, to be used by AcquireFrame()
+* @return  Code of the first error encountered (e.g. checksum error in a tile), otherwise OK 
+*/
+STATUS GetImageRegion(string ref, int x, int y, int width, int height, unsigned long *psequence);
+
 /** It returns the saved images' references.
+
+Note: The references are read from the mapped index of the image store. It includes the images which are queued but not persisted yet.
+
 * @return  Reference list 
 */
 string GetRefList();
 
+/** It returns the catalog entry of a saved image.
+* @param ref : A reference to the name of the saved image
+* @param *pinfo : image information
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS GetImageInfo(string ref, IMAGE_INFO *pinfo);
+
+/** It returns one page of the saved images' references which match a query, sorted by capture time.
+* @param query : filter on filter_id, exposure and capture time
+* @param cursor : 0 for the first page, otherwise the value of *pnext returned by the previous page
+* @param count : maximum number of references in the page
+* @param *preflist : Reference list of the page
+* @param *pnext : cursor of the next page, 0 if it is the last page
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS GetRefPage(IMAGE_QUERY query, int cursor, int count, string *preflist, int *pnext);
+
 /** It deletes an image by using its reference. 
+
+Note: The image is removed from the catalog; its space in the image store is reclaimed later.
+
 * @param ref : A reference to the name of the saved image
 * @return  status  
 */
 STATUS DeleteImage(string ref);
 
 /** It erases all the images and the clear the ref list.
+
+Note: It takes a constant time. It starts a new generation of the catalog and the images of the previous generations are reclaimed later.
+
 * @return  Code of the first error encountered, otherwise OK 
 */
  STATUS DeleteAll();
+
+/** It reclaims the space of the deleted images in the image store. It is called by the writer thread when it is idle.
+* @param number : maximum number of images to reclaim, -1 for all
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS ReclaimStore(int number);
 /*! @} */
@@ -0,0 +1,125 @@
+/*! \addtogroup Journal
+* This module provides the record and the replay of the command streams of the Mast and the IR Camera modules.
+*
+* When the recorder is started, every call of a public function of the Mast and the IR Camera modules is written in a lock-free buffer with its arguments,
+* its STATUS and its timestamps. A background thread writes the buffer to a compact binary journal. Each function is identified by its BUS_COMMAND
+* (every public function of the two modules, including the asynchronous variants, has one), and the arguments and the return arguments are encoded as in the Bus module.
+*
+* The journal is written on the rover and replayed on another computer, so its layout is fixed: it uses the fixed-width types of stdint.h,
+* in little-endian byte order and without padding. It starts with a JOURNAL_HEADER (32 bytes), followed by the entries (JOURNAL_ENTRY is 32 bytes).
+* The BUS_COMMAND values are the identifiers of the functions in the journal; they are only appended in new builds, so a journal can be replayed
+* by a build with the same format version and at least as many Commands. Otherwise Journal_Replay() returns an error without replaying.
+*
+* If the buffer is full, the entries are dropped; the recorder then writes a JOURNAL_DROPPED entry with the number of dropped calls at their position.
+* A journal with dropped calls cannot be replayed deterministically: Journal_Replay() reports them and returns an error without replaying.
+*
+* The replayer reads a journal and calls the same functions in the same order, on the current backend (e.g. the simulator started by Sim_Init()),
+* at full speed or with the recorded timing. It reports the calls which return a different STATUS than the recorded one.
+*
+* The handles returned by the functions (MAST_TOKEN, SAVE_TICKET, image references, frame sequence numbers and IR_FRAME) have other values in the replay.
+* The replayer keeps a preallocated table from each recorded handle (read from the recorded return arguments) to the live handle returned by the replayed call,
+* and replaces the recorded handles in the arguments of the following calls (e.g. Mast_Wait(), WaitSave(), GetImage(), AcquireFrame(), ReleaseFrame()) by the live ones.
+* The pixels pointer of IR_FRAME is not recorded. A handle which differs from the recorded one is not a mismatch.
+* So a field session can be run again offline, to find regressions and to benchmark the planner or the image pipeline on real workloads.
+*
+* - Journal_Start(string path, int size)
+* - Journal_Stop()
+* - Journal_Replay(string path, enum JOURNAL_TIMING timing, JOURNAL_REPORT *preport)
+*  @{
+*/
+
+
+/** JOURNAL_TIMING
+
+* It defines the timing of the replay.
+*/
+
+enum JOURNAL_TIMING{
+	TIMING_FULL_SPEED, /**< Each call starts when the previous one is finished */
+	TIMING_RECORDED /**< Each call starts at its recorded time from the start of the journal */
+	
+}; 
+
+
+/** Command of the entry which replaces the dropped calls. Its status is the number of dropped calls. */
+#define JOURNAL_DROPPED 0xFFFF
+
+/** Magic number at the start of a journal ("MASTJRNL" in little-endian byte order) */
+#define JOURNAL_MAGIC 0x4C4E524A5453414DULL
+
+/** Format version of the journal, it changes when the layout of the header or the entries changes */
+#define JOURNAL_VERSION 1
+
+
+/** Journal Header
+
+* It is the header at the start of the journal.
+*/
+
+typedef struct 
+{
+	uint64_t magic ; /**< JOURNAL_MAGIC */ 
+	uint32_t version ; /**< JOURNAL_VERSION of the recorder */ 
+	uint32_t commands ; /**< BUS_COMMANDS of the recorder */ 
+	uint64_t start_time ; /**< Start of the journal, in nanosecond since 1970-01-01 UTC */ 
+	uint32_t entry_size ; /**< Size of JOURNAL_ENTRY, in byte */ 
+	uint32_t reserved ; /**< 0 */ 
+} JOURNAL_HEADER;
+
+
+/** Journal Entry
+
+* It is the fixed header of each entry of the journal. It is followed by the encoded arguments and the encoded return arguments.
+*/
+
+typedef struct 
+{
+	uint64_t time_start ; /**< Call time, in nanosecond from the start of the journal */ 
+	uint64_t duration ; /**< Duration of the call, in nanosecond */ 
+	int32_t status ; /**< STATUS returned by the function, or the number of dropped calls for JOURNAL_DROPPED */ 
+	uint16_t command ; /**< BUS_COMMAND of the function, or JOURNAL_DROPPED */ 
+	uint16_t thread ; /**< ID of the calling thread */ 
+	uint32_t length ; /**< Length of the encoded arguments, in byte */ 
+	uint32_t return_length ; /**< Length of the encoded return arguments, in byte */ 
+} JOURNAL_ENTRY;
+
+
+/** Journal Report
+
+* It includes the result of Journal_Replay().
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< OK or NOT_OK  */ 
+	int calls ; /**< Number of replayed calls */ 
+	int mismatches ; /**< Number of calls which returned a different STATUS than the recorded one */ 
+	int first_mismatch ; /**< Index of the first mismatching call, -1 if there is none */ 
+	int dropped ; /**< Number of calls dropped by the recorder; if it is not 0, nothing is replayed */ 
+	double recorded_duration ; /**< Duration of the recorded session, in second */ 
+	double duration ; /**< Duration of the replay, in second */ 
+} JOURNAL_REPORT;
+
+
+
+/** It starts the recorder. If the buffer is full, the entries are dropped and a JOURNAL_DROPPED entry is written in their place.
+* @param path : Path of the journal
+* @param size : Size of the lock-free buffer, in entries
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Journal_Start(string path, int size);
+
+/** It stops the recorder and writes the remaining entries to the journal.
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Journal_Stop();
+
+/** It replays a journal on the current backend.
+* @param path : Path of the journal
+* @param timing : JOURNAL_TIMING
+* @param *preport : replay report
+* @return  Code of the first error encountered (e.g. corrupted journal, wrong magic number or version, more Commands than this build, the journal has dropped calls), otherwise OK 
+*/
+STATUS Journal_Replay(string path, enum JOURNAL_TIMING timing, JOURNAL_REPORT *preport);
+
+/*! @} */
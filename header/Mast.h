@@ -23,10 +23,13 @@
 *
 * \subsection subsec1 Initialization 
 *
-* The Robotic Mast should be initialized before operation. All the following functions should be called to initialize the Mast module
+* The Robotic Mast should be initialized before operation. All the following functions should be called to initialize the Mast module, in this order
+* - Mast_SetMastRootPosition(double x, double y, double z, double roll, double pitch, double yaw)
 * - Mast_SetBinPos(int binID, double x, double y, double z)
 * - Mast_SetJointPara(int JointID, JOINT_PARA para)
-* - Mast_SetMastRootPosition(double x, double y, double z, double roll, double pitch, double yaw)
+* - Mast_SetControlRate(double rate, int size)
+* - Mast_StartControlLoop(int cpu, int priority)
+* - Mast_BuildModeTable()
 
 * Then, by calling Mast_SelfTest(), a set of tests will be executed to verify the functionality of the hardware and the software.
 
@@ -37,6 +40,8 @@ For changing the mast mode, the following functions can be called:
 
 
 
+* When several users access the mast, the motion commands are accepted only from the session which holds the motion lease (see the Session module).
+*
 * The users do not have access to the functions that change the configuration of the Mast except in \b Active and \b Scan mode. So, for any operation that required moving the Mast
 * manually, users should call Mast_SetMode( enum MAST_MODE mode) and use SCAN or ACTIVE as input.
 *
@@ -62,6 +67,11 @@ For changing the mast mode, the following functions can be called:
 *   - Mast_TurnLeft(double angle)
 *   - Mast_TurnDown(double angle)
 *   - Mast_TurnUp(double angle)
+*
+* In SCAN mode, these functions go through a streaming teleoperation channel. They do not queue a separate move: the increment is added to a single pending target
+* of the first and the second joints, and the control loop always follows the latest target. So a flood of joystick commands does not lag behind the operator.
+* The second link is kept parallel to the first link for each merged target. The latency from the call to the start of the motion is measured by Mast_GetTeleopLatency().
+* The motion lease of the teleoperation session is kept until the target has been reached, so another session cannot move the mast between two increments.
      
 
 
@@ -72,10 +82,21 @@ For changing the mast mode, the following functions can be called:
 * - \b Sample \b Retrieving:  Retrieving a sample by scooping an input location. There is a verification procedure in the loop to verify if there is sample in the scoop or no.
 * - \b Scooping: Scooping an input location without any verification.
 * - \b Sample \b Dumping: Dumping the retrieved sample in the sample bin.
+* - \b Sample \b Campaign: Retrieving and dumping a list of samples. The targets which are out of the IK workspace are removed, and the other ones are ordered
+* to minimize the total joint travel. The retrieve and dump cycles are chained without going back to home between them.
 *
 * The following functions can be used to command the tasks:
 * - Mast_SampleRetrieve(double x, double y, double z)
 * - Mast_SampleDump(int binID)
+* - Mast_PlanCampaign(MAST_TARGET targets[], int number, int order[], int *preachable)
+* - Mast_RunCampaign(MAST_TARGET targets[], int number, MAST_CAMPAIGN_REPORT *preport)
+*
+* The verification compares two images of the scoop. The images are read from the IR Camera frame ring without copying them,
+* split in tiles which are compared in parallel by a vectorized differencing kernel, and the comparison stops as soon as
+* the number of changed pixels crosses the threshold. The region statistics used for the decision are returned.
+*
+* - Mast_SetVerifyPara(MAST_VERIFY_PARA para)
+* - Mast_SampleVerifyFrames(unsigned long seq1, unsigned long seq2, bool *success, MAST_VERIFY_STAT *pstat)
 *
         
 * \subsection subsec4 Query Functions
@@ -88,6 +109,66 @@ For changing the mast mode, the following functions can be called:
 * - Mast_GetHomeConfig(MAST_CONFIG *pconf)
 * - Mast_GetEndEffectorPos(END_EFFECTOR_POS *ppos)
 * - Mast_GetMode(enum MAST_MODE *pmode)
+* - Mast_GetState(MAST_STATE *pstate)
+*
+* The control loop publishes a state snapshot (joint values, velocities, currents, mode and end effector position) at each control tick.
+* The snapshot is protected by a sequence lock, so the query functions read it without any round trip to the mast control computer
+* and without blocking the motion commands. Mast_GetState() returns all of them from one consistent snapshot.
+*
+* \subsection subsec5 Kinematics
+*
+* The inverse and forward kinematics are used by Mast_SetEndEffectorPos(END_EFFECTOR_POS pos) and Mast_GetEndEffectorPos(END_EFFECTOR_POS *ppos).
+* The fixed transform chain (from the robot coordination to the mast root and along the links) is built once, when Mast_SetMastRootPosition() or Mast_SetJointPara() is called.
+* Each query is then solved in closed form, or by an iterative solver warm-started from the current configuration, without heap allocation.
+* The solutions are cached by the quantized (x, y, z, theta), so the repeated targets (e.g. the bin positions and the home configuration) are solved once.
+*
+* - Mast_SolveIK(END_EFFECTOR_POS pos, MAST_CONFIG *pconf)
+* - Mast_SolveFK(MAST_CONFIG conf, END_EFFECTOR_POS *ppos)
+* - Mast_SetIKCache(int size, double resolution)
+* - Mast_BenchmarkIK(int number, MAST_IK_BENCH *preport)
+*
+* \subsection subsec6 Trajectory
+*
+* Every motion (Mast_SetJointValues(), Mast_SetJointValue(), Mast_SetEndEffectorPos() and the motions of Mast_SampleRetrieve() and Mast_SampleDump())
+* follows a jerk-limited and time-optimal trajectory, within vel_max, acc_max and jerk_max of JOINT_PARA. All joints are synchronized, so they start and stop together.
+* A joint with jerk_max equal to 0 (e.g. a JOINT_PARA initialized without it) has no jerk limit, and its profile is limited by vel_max and acc_max only.
+* The setpoints are streamed to the joints at a fixed control rate from a preallocated streaming buffer, which is used only by the control loop.
+* Mast_PlanTrajectory() writes in a separate preallocated planning buffer, so planning never changes a running trajectory.
+*
+* - Mast_SetControlRate(double rate, int size)
+* - Mast_PlanTrajectory(MAST_CONFIG goal, MAST_TRAJECTORY *ptraj)
+* - Mast_GetSetpoint(int index, MAST_CONFIG *pconf)
+*
+* \subsection subsec7 Control Loop
+*
+* The mast is driven by a dedicated real-time control thread, pinned to one CPU and scheduled with SCHED_FIFO where it is allowed.
+* The commands reach the control thread through a lock-free command queue, and the halt commands use a separate priority lane,
+* so Mast_HaltAllJoints() and Mast_HaltJoint() preempt a motion which is already running.
+* Each motion function (Mast_SetMode(), Mast_SetJointValue(), Mast_SetJointValues(), Mast_SetEndEffectorPos(), Mast_HomeJoint(), Mast_HomeAllJoints(),
+* Mast_ResetJoint(), Mast_ResetAllJoints(), Mast_Scoop(), Mast_Drop(), Mast_SampleRetrieve() and Mast_SampleDump()) has an asynchronous variant
+* which returns a completion token instead of waiting for the end of the motion; the blocking function is the same as the asynchronous variant followed by Mast_Wait().
+*
+* The halt latency is bounded: a halt is taken by the control loop at the next control tick (at most one control period), and the joints are then stopped
+* by an emergency profile which uses acc_max without the jerk limit, so each joint stops within vel_max / acc_max. The deadline set by Mast_SetHaltDeadline()
+* is checked at each tick; if a joint is still moving at the deadline, its brake is engaged and the motor power is cut, and the miss is counted by Mast_GetHaltLatency().
+*
+* - Mast_StartControlLoop(int cpu, int priority)
+* - Mast_StopControlLoop()
+* - Mast_Wait(MAST_TOKEN token, int timeout, STATUS *presult)
+* - Mast_SetHaltDeadline(double deadline)
+* - Mast_GetHaltLatency(MAST_LATENCY *plat)
+*
+* \subsection subsec8 Mode Transitions
+*
+* The paths between the configurations of each pair of MAST_MODE (STOWAGE, NAVIGATION, ACTIVE home and SCAN, with the second link parallel to the first one)
+* are planned once in the initialization, after Mast_SetJointPara() and Mast_SetMastRootPosition(). They are collision free with the rover body
+* and the obstacles set by Mast_SetObstacle(), and time optimal. They are kept in a lookup table as sampled trajectories,
+* so Mast_SetMode() replays a path without any online planning. When a joint parameter is changed, only the paths which are not valid anymore are planned again.
+*
+* - Mast_SetObstacle(int obstacleID, double x, double y, double z, double radius)
+* - Mast_BuildModeTable()
+* - Mast_GetModePath(enum MAST_MODE from, enum MAST_MODE to, MAST_TRAJECTORY *ptraj)
+* - Mast_GetModeSetpoint(enum MAST_MODE from, enum MAST_MODE to, int index, MAST_CONFIG *pconf)
 
 
 
@@ -110,9 +191,29 @@ enum MAST_MODE{
 
 
 
+/** Number of joints of the Robotic Mast
+
+* To be defined: the final number of joints. It is used by the compile-time joint model (MastModel.h).
+*/
+
+#define MAST_JOINTS 4
+
+
 /** Robotic Mast configuration
 
-/* It includes the value of the Robotic Mast DOF.
+* It includes the value of the Robotic Mast DOF, indexed by Joint ID.
+*/
+
+typedef struct
+{
+	double joint[MAST_JOINTS] ; /**< Joint values, in radius */ 
+} MAST_CONFIG;
+
+
+
+/** End effector position
+
+* It includes the position of the end effector and the attack angle of the scoop.
 */
 
 typedef struct
@@ -143,9 +244,146 @@ typedef struct
  double vel_max ; // Maximum velocity of the joint, in radius/second
  double acc_max ; // Maximum acceleration of the joint, in radius/second2
  double curr_max ; // Maximum current of the joint, in ampere
+ double jerk_max ; // Maximum jerk of the joint, in radius/second3; 0 means no jerk limit
 } JOINT_PARA;
 
 
+/** IK Benchmark Report
+
+* It includes the result of Mast_BenchmarkIK().
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< OK or NOT_OK  */ 
+	int number ; /**< Number of solved targets */ 
+	double solves_per_second ; /**< Number of solved targets per second */ 
+	double p50 ; /**< Median latency of one solve, in microsecond */ 
+	double p99 ; /**< 99th percentile latency of one solve, in microsecond */ 
+	double cache_hit ; /**< Ratio of the targets solved by the cache */ 
+} MAST_IK_BENCH;
+
+
+/** Mast Trajectory
+
+* It describes a trajectory computed by Mast_PlanTrajectory().
+*/
+
+typedef struct 
+{
+	double duration ; /**< Duration of the trajectory, in second */ 
+	int setpoints ; /**< Number of setpoints in the buffer */ 
+	int limiting_joint ; /**< Joint ID which limits the duration */ 
+} MAST_TRAJECTORY;
+
+
+/** Completion Token
+
+* It is returned by the asynchronous functions and it is used by Mast_Wait() to wait for the end of the command.
+*/
+
+typedef unsigned long MAST_TOKEN;
+
+
+/** Latency Report
+
+* It includes the statistics of a measured latency, in microsecond.
+*/
+
+typedef struct 
+{
+	int samples ; /**< Number of samples */ 
+	double min ; /**< Minimum latency */ 
+	double mean ; /**< Mean latency */ 
+	double p99 ; /**< 99th percentile latency */ 
+	double max ; /**< Maximum latency */ 
+	int misses ; /**< Number of samples over the deadline, 0 if there is no deadline */ 
+} MAST_LATENCY;
+
+
+/** Sample Verification Parameters
+
+* It defines the parameters of the image differencing used by Mast_SampleVerify().
+*/
+
+typedef struct 
+{
+	int pixel_delta ; /**< Minimum difference for a pixel to be counted as changed */ 
+	int threshold ; /**< Number of changed pixels which means there is sample in the scoop */ 
+	int tile ; /**< Tile size in pixel (square tiles) */ 
+	int roi_x ; /**< Scoop region of interest, x of the top left corner in pixel, in full image coordinates */ 
+	int roi_y ; /**< Scoop region of interest, y of the top left corner in pixel, in full image coordinates */ 
+	int roi_width ; /**< Scoop region of interest, width in pixel, 0 for the whole image */ 
+	int roi_height ; /**< Scoop region of interest, height in pixel, 0 for the whole image */ 
+} MAST_VERIFY_PARA;
+
+
+/** Sample Verification Statistics
+
+* It includes the statistics of the region used by the last verification.
+*/
+
+typedef struct 
+{
+	int changed ; /**< Number of changed pixels counted before the decision */ 
+	int pixels ; /**< Number of compared pixels */ 
+	int tiles ; /**< Number of compared tiles */ 
+	int tiles_total ; /**< Number of tiles in the region of interest */ 
+	double mean_delta ; /**< Mean difference of the compared pixels */ 
+	int max_delta ; /**< Maximum difference of the compared pixels */ 
+	bool early_exit ; /**< true if the comparison stopped when the threshold was crossed */ 
+	double duration ; /**< Duration of the verification, in ms */ 
+} MAST_VERIFY_STAT;
+
+
+/** Mast State
+
+* It is the state snapshot published by the control loop.
+*/
+
+typedef struct 
+{
+	unsigned long version ; /**< Version of the snapshot, it increases at each control tick */ 
+	double time ; /**< Time of the snapshot, in second */ 
+	enum MAST_MODE mode ; /**< Mast mode */ 
+	MAST_CONFIG conf ; /**< Joint values */ 
+	MAST_CONFIG vel ; /**< Joint velocities, in radius/second */ 
+	MAST_CONFIG curr ; /**< Joint currents, in ampere */ 
+	END_EFFECTOR_POS pos ; /**< End effector position */ 
+	bool moving ; /**< true if a motion is running */ 
+} MAST_STATE;
+
+
+/** Campaign Target
+
+* It defines one sample of a campaign: the sample coordination and the bin to dump it.
+*/
+
+typedef struct 
+{
+	double x ; /**< Sample coordination along x axis  */ 
+	double y ; /**< Sample coordination along y axis  */ 
+	double z ; /**< Sample coordination along z axis  */ 
+	int binID ; /**< Bin ID */ 
+	STATUS status ; /**< Result of the target, set by Mast_RunCampaign() */ 
+} MAST_TARGET;
+
+
+/** Campaign Report
+
+* It includes the result of Mast_RunCampaign().
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< OK or NOT_OK  */ 
+	int reachable ; /**< Number of reachable targets */ 
+	int retrieved ; /**< Number of retrieved and dumped samples */ 
+	double joint_travel ; /**< Total joint travel, in radius */ 
+	double duration ; /**< Duration of the campaign, in second */ 
+} MAST_CAMPAIGN_REPORT;
+
+
 // Operation Functions
 
 /** It bring the Mast to one of the desired mode and return a proper status message. 
@@ -162,17 +400,30 @@ typedef struct
 *
 * \b STOWAGE: Move the mast to stowage configuration, with the lowest center of gravity. 
 * Mast will be in the locked configuration in stowage state. users (executive level) does not have access to any function to move the mast.
+*
+* Note: The path from the current mode is replayed from the mode transition table. If the mast is not in the configuration of a mode (e.g. after a halt),
+* a path to the configuration of the requested mode is planned online, collision free with the rover body and the obstacles set by Mast_SetObstacle();
+* if no collision free path is found, the mast does not move and an error is returned.
 * @return  Code of the first error encountered, otherwise OK 
 */
 STATUS Mast_SetMode( enum MAST_MODE mode); 
 
 /** It returns the operation mode of the mast.
 
+Note: It is read from the state snapshot.
+
 * @param   pmode : mast mode
 * @return  Code of the first error encountered, otherwise OK 
 */
 STATUS Mast_GetMode(enum MAST_MODE *pmode);
 
+/** It returns the state of the mast from one consistent snapshot.
+
+* @param   *pstate : mast state
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_GetState(MAST_STATE *pstate);
+
 
 /** It calls a list of tests to verify the concerning hardware and software.
 
@@ -203,6 +454,8 @@ STATUS Mast_HomeAllJoints();
 
 /** It halt the specific joint, It is used in emergency situation or due to errors.
 
+Note: The command goes through the priority lane of the control loop and preempts the running motion.
+
 * @param  jointID : Joint ID
 *  @return  Code of the first error encountered, otherwise OK 
 */
@@ -211,6 +464,9 @@ STATUS Mast_HaltJoint(int jointID);
 
 /** It halt all joints, It is used in emergency situation
 
+Note: The command goes through the priority lane of the control loop and preempts the running motion and the queued commands.
+The time from the call to the stop of all joints is measured by Mast_GetHaltLatency().
+
 *  @return  Code of the first error encountered, otherwise OK 
 */
 STATUS Mast_HaltAllJoints();
@@ -233,7 +489,8 @@ STATUS Mast_ResetAllJoints();
 /** It associate a releasing position to each sample bin ID. 
 
 Note: The position is defined in the robot coordination.
-Note: Calling this function is mandatory. Calling any other function should return error before initialization of at least one sample bin position.
+Note: Calling this function is mandatory. Calling any other function should return error before initialization of at least one sample bin position,
+except the configuration functions of the initialization (Mast_SetMastRootPosition(), Mast_SetBinPos(), Mast_SetJointPara() and Mast_SetControlRate()).
 
 *  @param  binID : An ID which defines each sample bin.
 *  @param  x : scooping coordination
@@ -245,6 +502,9 @@ STATUS Mast_SetBinPos(int binID, double x, double y, double z);
 
 /** It sets the joint parameters
 
+Note: The kinematic chain is rebuilt and the IK cache is cleared.
+Note: The paths of the mode transition table which do not respect the new parameters are planned again.
+
 * @param JointID : Joint ID.
 * @param para : Joint parameter.
 
@@ -263,6 +523,9 @@ STATUS Mast_GetJointPara(int JointID, JOINT_PARA *ppara);
 
 /** It sets a joint value.
 
+Note: The joint follows a time-optimal trajectory within its JOINT_PARA limits.
+Note: The Joint ID is checked at run time. Mast_SetJointValue<ID>(double value) of MastModel.h checks it at compile time.
+
 * @param jointID : Joint ID
 * @param value : Joint  value.
 
@@ -272,6 +535,8 @@ STATUS Mast_SetJointValue(int jointID, double value);
 
 /** It return the joint value.
 
+Note: It is read from the state snapshot.
+
 * @param jointID : Joint ID
 * @param *pvalue : Joint  value.
 
@@ -281,6 +546,8 @@ STATUS Mast_GetJointValue(int jointID, double *pvalue);
 
 /** It returns the joint values (Mast configuration).
 
+Note: The joints follow a synchronized, time-optimal trajectory computed by Mast_PlanTrajectory().
+
 * @param conf : mast configuration
 * @return   Mast current configuration.
 */
@@ -288,15 +555,45 @@ STATUS Mast_SetJointValues(MAST_CONFIG conf);
 
 /** It returns the joint values (Mast configuration).
 
+Note: It is read from the state snapshot.
+
 * @param * pconf : mast configuration
 * @return   Mast current configuration.
 */
 STATUS Mast_GetJointValues(MAST_CONFIG *pconf);
 
+/** It sets the control rate of the trajectories and the size of the preallocated setpoint buffers (the streaming buffer and the planning buffer).
+
+Note: It should be called in the initialization.
+
+* @param rate : control rate in Hz
+* @param size : number of setpoints in each buffer; a longer trajectory returns error
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_SetControlRate(double rate, int size);
+
+/** It computes the jerk-limited, time-optimal and synchronized trajectory from the current configuration to a goal configuration.
+* The setpoints are written in the planning buffer, not in the streaming buffer of the control loop. The mast does not move and a running motion is not changed.
+
+* @param goal : goal configuration
+* @param *ptraj : trajectory
+* @return  Code of the first error encountered (e.g. the goal is out of the joint limits), otherwise OK 
+*/
+STATUS Mast_PlanTrajectory(MAST_CONFIG goal, MAST_TRAJECTORY *ptraj);
+
+/** It returns a setpoint of the last trajectory computed by Mast_PlanTrajectory().
+
+* @param index : index of the setpoint, between 0 and setpoints - 1
+* @param *pconf : setpoint configuration
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_GetSetpoint(int index, MAST_CONFIG *pconf);
+
 /** It sets the end effector position in the coordination of the robot and the attack angle of the scoop.
 
 Question: Where is the end effector? Is it the last joint before scoop or it is a center of the scoop?
 Question: What is the attack angle? is it the value of the last joint?
+Note: The joint values are computed by Mast_SolveIK().
 
 *  @param  pos : scoop coordination
 * @return  Code of the first error encountered, otherwise OK 
@@ -305,14 +602,52 @@ STATUS Mast_SetEndEffectorPos(END_EFFECTOR_POS pos);
 
 /** It returns the end effector position in the coordination of the robot and the attack angle of the scoop.
 
+Note: It is read from the state snapshot.
+
 *  @param  *ppos : scoop coordination
 * @return  Code of the first error encountered, otherwise OK 
 */
 STATUS Mast_GetEndEffectorPos(END_EFFECTOR_POS *ppos);
 
+/** It computes the joint values which bring the end effector to a position (inverse kinematics). The mast does not move.
+
+Note: The solution is looked up in the IK cache first.
+
+*  @param  pos : scoop coordination
+*  @param  *pconf : mast configuration
+* @return  Code of the first error encountered (e.g. the position is not reachable), otherwise OK 
+*/
+STATUS Mast_SolveIK(END_EFFECTOR_POS pos, MAST_CONFIG *pconf);
+
+/** It computes the end effector position of a mast configuration (forward kinematics). The mast does not move.
+
+*  @param  conf : mast configuration
+*  @param  *ppos : scoop coordination
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_SolveFK(MAST_CONFIG conf, END_EFFECTOR_POS *ppos);
+
+/** It sets the IK cache.
+
+*  @param  size : maximum number of cached solutions, 0 to disable the cache
+*  @param  resolution : quantization step of x, y and z in meter; theta is quantized by resolution in radian
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_SetIKCache(int size, double resolution);
+
+/** It solves a set of random reachable targets and returns the solver throughput and latency. The mast does not move.
+
+*  @param  number : number of targets
+*  @param  *preport : benchmark report
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_BenchmarkIK(int number, MAST_IK_BENCH *preport);
+
 
 /** Retrieve the sample situated at position x,y and z. The location is defined in the robot local coordination.
 
+Note: After each scooping, the retrieval is verified by Mast_SampleVerifyFrames() and retried if there is no sample in the scoop.
+
 *  @param  x : scooping coordination
 *  @param  y : scooping coordination
 *  @param  z : scooping coordination
@@ -322,6 +657,9 @@ STATUS Mast_SampleRetrieve(double x, double y, double z);
 
 /** Verify if the sample retrieval effort is successful or not.
 
+Note: Only the scoop region of interest of the images is loaded in the IR Camera frame ring by GetImageRegion(), and the two frames are compared
+by Mast_SampleVerifyFrames() with the sequence numbers returned by GetImageRegion().
+
 *  @param  *img1 : first image
 *  @param  *img2 : second image
 *  @param  *success : success flag
@@ -329,16 +667,58 @@ STATUS Mast_SampleRetrieve(double x, double y, double z);
 */
 STATUS Mast_SampleVerify(string *img1, string *img2, bool *success);
 
+/** Verify if the sample retrieval effort is successful or not, by comparing two frames of the IR Camera frame ring.
+The frames are acquired by AcquireFrame() and are not copied. The tiles are compared in parallel and the comparison stops
+as soon as the number of changed pixels crosses the threshold of MAST_VERIFY_PARA.
+The region of interest of MAST_VERIFY_PARA is defined in full image coordinates; it is applied relative to the x0 and y0 of each frame (so it works for a region loaded by GetImageRegion()),
+and clipped to the frame. An error is returned if the two frames do not cover the same region.
+
+*  @param  seq1 : sequence number of the first frame
+*  @param  seq2 : sequence number of the second frame
+*  @param  *success : success flag
+*  @param  *pstat : statistics of the region used for the decision
+*  @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_SampleVerifyFrames(unsigned long seq1, unsigned long seq2, bool *success, MAST_VERIFY_STAT *pstat);
+
+/** It sets the parameters of the sample verification.
+
+*  @param  para : verification parameters
+*  @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_SetVerifyPara(MAST_VERIFY_PARA para);
+
 
 /** It dump the samples in the selected bin.
 
-Note: At the end of each function, the mast comes back to the home position. 
+Note: At the end of each function, the mast comes back to the home position, except between the cycles of Mast_RunCampaign(). 
 
 *  @param  binID : Bin ID
 *  @return  Code of the first error encountered, otherwise OK 
 */
 STATUS Mast_SampleDump(int binID);
 
+/** It plans a campaign. The targets which are not reachable (no IK solution for the sample or the bin) are removed,
+and the reachable ones are ordered to minimize the total joint travel. The mast does not move.
+
+*  @param  targets : list of targets
+*  @param  number : number of targets
+*  @param  order : indexes of the reachable targets in the visiting order (at least number elements)
+*  @param  *preachable : number of reachable targets
+*  @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_PlanCampaign(MAST_TARGET targets[], int number, int order[], int *preachable);
+
+/** It plans and runs a campaign. For each reachable target, the sample is retrieved and dumped in its bin, and the next cycle starts from the bin without going back to home.
+The mast comes back to the home position at the end of the campaign. The status of each target is set in the list.
+
+*  @param  targets : list of targets
+*  @param  number : number of targets
+*  @param  *preport : campaign report
+*  @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_RunCampaign(MAST_TARGET targets[], int number, MAST_CAMPAIGN_REPORT *preport);
+
 /** Inqure about the coordination of sample
 
 *  @param  *x : scooping coordination
@@ -369,7 +749,10 @@ STATUS Mast_ForwardSampleCoor(double *x, double *y, double *z);
 
 /** This function is used in initialization of the module to set the position and orientation of the Mast root cordination in the robot cordination. 
 Note: Mast root cordination is the coordination that the mast developer considers for his comupation. (Mast coordination in the coordination of the robot)
-Note: Calling this function is mandatory in initialization. Calling any other function should return error before setting the root position.
+Note: Calling this function is mandatory in initialization. Calling any other function should return error before setting the root position,
+except the configuration functions of the initialization (Mast_SetBinPos(), Mast_SetJointPara() and Mast_SetControlRate()).
+Note: The kinematic chain is rebuilt and the IK cache is cleared.
+Note: The mode transition table is not valid anymore; all its paths are planned again, because the position of the mast relative to the rover body has changed.
 
 *  @param  x : Coordination along x axis
 *  @param  y : Coordination along x axis
@@ -408,6 +791,7 @@ STATUS Mast_Drop();
 * @param   angle : Angle in Degree
 * @return   STATUS : Error code or OK.
 * Note: Mast should be in Scan Mode..
+* Note: The increment is merged in the teleoperation target, it returns without waiting for the motion.
 */
 STATUS Mast_TurnRight(double angle);
 
@@ -415,19 +799,207 @@ STATUS Mast_TurnRight(double angle);
 * @param   angle : Angle in Degree
 * @return   STATUS : Error code or OK.
 * Note: Mast should be in Scan Mode..
+* Note: The increment is merged in the teleoperation target, it returns without waiting for the motion.
 */
 STATUS Mast_TurnLeft(double angle);
 
 /** It moves the Arm down by using the second motor.
 * @param   angle : Angle in Degree
 * @return   STATUS : Error code or OK.
+* Note: The increment is merged in the teleoperation target, it returns without waiting for the motion.
 */
 STATUS Mast_TurnDown(double angle);
 
 /** It moves the Arm up by using teh second motor.
 * @param   angle : Angle in Degree
 * @return   STATUS : Error code or OK.
+* Note: The increment is merged in the teleoperation target, it returns without waiting for the motion.
 */
 STATUS Mast_TurnUp(double angle);
 
+/** It returns the latency of the teleoperation channel, from a Mast_Turn* call to the start of the concerning motion.
+* @param   *plat : teleoperation latency
+* @return   STATUS : Error code or OK.
+*/
+STATUS Mast_GetTeleopLatency(MAST_LATENCY *plat);
+
+/** It returns the pending teleoperation target of the first and the second joints, after merging the increments.
+* @param   *ppan : target of the first joint, in Degree
+* @param   *ptilt : target of the second joint, in Degree
+* @return   STATUS : Error code or OK.
+* Note: Mast should be in Scan Mode..
+*/
+STATUS Mast_GetTeleopTarget(double *ppan, double *ptilt);
+
+// Mode Transitions
+
+/** It sets an obstacle to avoid, as a sphere in the robot coordination. The rover body is always avoided.
+
+*  @param  obstacleID : obstacle ID
+*  @param  x : center coordination
+*  @param  y : center coordination
+*  @param  z : center coordination
+*  @param  radius : radius in meter, 0 to remove the obstacle
+*  @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_SetObstacle(int obstacleID, double x, double y, double z, double radius);
+
+/** It plans the paths between all pairs of modes and fills the mode transition table. It is called at the end of the initialization.
+
+Note: The paths are planned again if an obstacle is changed.
+
+*  @return  Code of the first error encountered (e.g. no collision free path), otherwise OK 
+*/
+STATUS Mast_BuildModeTable();
+
+/** It returns the path between two modes from the mode transition table. The mast does not move.
+
+*  @param  from : initial mode
+*  @param  to : final mode
+*  @param  *ptraj : trajectory of the path
+*  @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_GetModePath(enum MAST_MODE from, enum MAST_MODE to, MAST_TRAJECTORY *ptraj);
+
+/** It returns a setpoint of the path between two modes, read from the mode transition table. The mast does not move.
+
+*  @param  from : initial mode
+*  @param  to : final mode
+*  @param  index : index of the setpoint, between 0 and setpoints - 1 of Mast_GetModePath()
+*  @param  *pconf : setpoint configuration
+*  @return  Code of the first error encountered (e.g. the table is being planned again), otherwise OK 
+*/
+STATUS Mast_GetModeSetpoint(enum MAST_MODE from, enum MAST_MODE to, int index, MAST_CONFIG *pconf);
+
+
+// Control Loop
+
+/** It starts the real-time control thread. It is called in the initialization.
+
+Note: If SCHED_FIFO is not allowed, the thread runs with the default scheduling and an error is reported in Mast_GetReport().
+
+* @param   cpu : CPU to pin the control thread, -1 for no pinning
+* @param   priority : SCHED_FIFO priority, between 1 and 99
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_StartControlLoop(int cpu, int priority);
+
+/** It halts all joints and stops the real-time control thread.
+
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_StopControlLoop();
+
+/** It waits for the end of a command sent by an asynchronous function.
+
+* @param   token : completion token
+* @param   timeout : Timeout in ms, 0 to return immediately, -1 to wait without timeout
+* @param   *presult : STATUS of the command
+* @return  OK if the command is finished, otherwise error code (e.g. timeout)
+*/
+STATUS Mast_Wait(MAST_TOKEN token, int timeout, STATUS *presult);
+
+/** It sets the deadline from a halt command to the stop of the joints. At the deadline, the brakes of the moving joints are engaged and the motor power is cut.
+
+Note: By default, the deadline is one control period plus the largest vel_max / acc_max of the joints, with a margin of 20%.
+A smaller deadline than one control period plus vel_max / acc_max returns error.
+
+* @param   deadline : halt deadline, in ms
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_SetHaltDeadline(double deadline);
+
+/** It returns the measured latency from a halt command to the stop of the joints, and the number of halts which missed the deadline.
+
+* @param   *plat : halt latency
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mast_GetHaltLatency(MAST_LATENCY *plat);
+
+
+// Asynchronous Functions
+
+/** Asynchronous variant of Mast_SetMode( enum MAST_MODE mode).
+* @param   mode : MAST_MODE
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_SetModeAsync(enum MAST_MODE mode, MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_SetJointValue(int jointID, double value).
+* @param   jointID : Joint ID
+* @param   value : Joint value
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_SetJointValueAsync(int jointID, double value, MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_SetJointValues(MAST_CONFIG conf).
+* @param   conf : mast configuration
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_SetJointValuesAsync(MAST_CONFIG conf, MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_SetEndEffectorPos(END_EFFECTOR_POS pos).
+* @param   pos : scoop coordination
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_SetEndEffectorPosAsync(END_EFFECTOR_POS pos, MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_HomeAllJoints().
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_HomeAllJointsAsync(MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_HomeJoint(int jointID).
+* @param   jointID : Joint ID
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_HomeJointAsync(int jointID, MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_ResetJoint(int jointID).
+* @param   jointID : Joint ID
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_ResetJointAsync(int jointID, MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_ResetAllJoints().
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_ResetAllJointsAsync(MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_Scoop().
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_ScoopAsync(MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_Drop().
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_DropAsync(MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_SampleRetrieve(double x, double y, double z).
+* @param   x : scooping coordination
+* @param   y : scooping coordination
+* @param   z : scooping coordination
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_SampleRetrieveAsync(double x, double y, double z, MAST_TOKEN *ptoken);
+
+/** Asynchronous variant of Mast_SampleDump(int binID).
+* @param   binID : Bin ID
+* @param   *ptoken : completion token
+* @return  Code of the first error encountered in queuing the command, otherwise OK 
+*/
+STATUS Mast_SampleDumpAsync(int binID, MAST_TOKEN *ptoken);
+
 /*! @} */
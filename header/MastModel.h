@@ -0,0 +1,212 @@
+/*! \addtogroup MastModel
+* This module provides the compile-time joint model of the Robotic Mast, used by the control loop in every control tick.
+*
+* The number of joints and the link lengths are fixed at compile time by MAST_GEOMETRY. The joint parameters set by Mast_SetJointPara() are kept
+* in SoA arrays (one array per parameter), so the limit check and the forward kinematics are unrolled loops over contiguous values,
+* without branches in the check and without allocation.
+*
+* The Joint IDs known at compile time and the mechanical ranges of the joints are validated by static_assert. The C-compatible Mast_* functions keep their signatures and use MAST_MODEL internally.
+*
+* - MastModel<Geometry>::SetPara(int jointID, JOINT_PARA para)
+* - MastModel<Geometry>::InLimits(const MAST_CONFIG &conf)
+* - MastModel<Geometry>::Forward(const MAST_CONFIG &conf, END_EFFECTOR_POS *ppos)
+*  @{
+*/
+
+
+/** Mast Geometry
+
+* It defines the kinematic parameters of the mast at compile time. Joint 0 turns around the z axis of the mast root, the other joints turn in the vertical plane of the arm.
+* link(0) is the height of joint 1 above the root, and link(i) is the length of the link after joint i.
+* range_min(i) and range_max(i) are the mechanical range of joint i; the limits set by Mast_SetJointPara() should be inside it.
+
+* To be defined: the final link lengths, in meter, and the mechanical ranges, in radius.
+*/
+
+struct MAST_GEOMETRY
+{
+	static constexpr int joints = MAST_JOINTS;
+	static constexpr double link(int i) { return i == 0 ? 0.30 : i == 1 ? 0.50 : i == 2 ? 0.45 : 0.15; }
+	static constexpr double range_min(int i) { return i == 0 ? -3.10 : -2.60; }
+	static constexpr double range_max(int i) { return i == 0 ? 3.10 : 2.60; }
+};
+
+
+/** It returns true if the link lengths of a Geometry from link(i) are positive. It is used in constant expressions. */
+
+template <class Geometry>
+constexpr bool MastValidLinks(int i)
+{
+	return i >= Geometry::joints || (Geometry::link(i) > 0 && MastValidLinks<Geometry>(i + 1));
+}
+
+
+/** It returns true if a joint range is valid. It is used in constant expressions. */
+
+constexpr bool MastValidRange(double pos_min, double pos_max)
+{
+	return pos_min <= pos_max;
+}
+
+
+/** It returns true if the mechanical ranges of a Geometry from joint i are valid. It is used in constant expressions. */
+
+template <class Geometry>
+constexpr bool MastValidRanges(int i)
+{
+	return i >= Geometry::joints || (MastValidRange(Geometry::range_min(i), Geometry::range_max(i)) && MastValidRanges<Geometry>(i + 1));
+}
+
+
+/** Compile-time joint model
+
+* It keeps the joint limits in SoA arrays and provides the limit check and the forward kinematics of a mast with Geometry::joints joints.
+*/
+
+template <class Geometry>
+class MastModel
+{
+public:
+	static constexpr int joints = Geometry::joints;
+
+	static_assert(joints >= 2 && joints <= 8, "The mast should have between 2 and 8 joints");
+	static_assert(MastValidLinks<Geometry>(0), "The link lengths should be positive");
+	static_assert(MastValidRanges<Geometry>(0), "The mechanical ranges should not be empty");
+
+	/** The limits of all joints are empty (pos_min > pos_max), so InLimits() fails for a joint until SetPara() is called for it. */
+	MastModel()
+	{
+		for (int i = 0; i < joints; i++)
+		{
+			pos_min[i] = 1;
+			pos_max[i] = -1;
+			vel_max[i] = 0;
+			acc_max[i] = 0;
+		}
+	}
+
+	/** It returns true if a Joint ID is valid. It can be used in constant expressions. */
+	static constexpr bool ValidJoint(int jointID) { return jointID >= 0 && jointID < joints; }
+
+	/** It returns true if a joint range is valid. It can be used in constant expressions. */
+	static constexpr bool ValidRange(double pos_min, double pos_max) { return MastValidRange(pos_min, pos_max); }
+
+	/** It sets the limits of a joint.
+	* @param jointID : Joint ID
+	* @param para : Joint parameter
+	* @return  false if the Joint ID or the range is not valid, or the range is not inside the mechanical range of the joint
+	*/
+	bool SetPara(int jointID, JOINT_PARA para)
+	{
+		if (!ValidJoint(jointID) || !ValidRange(para.pos_min, para.pos_max)
+			|| para.pos_min < Geometry::range_min(jointID) || para.pos_max > Geometry::range_max(jointID))
+			return false;
+		pos_min[jointID] = para.pos_min;
+		pos_max[jointID] = para.pos_max;
+		vel_max[jointID] = para.vel_max;
+		acc_max[jointID] = para.acc_max;
+		return true;
+	}
+
+	/** It checks all the joint values against their limits, without branches.
+	* @param conf : mast configuration
+	* @return  true if all the joint values are within the limits
+	*/
+	bool InLimits(const MAST_CONFIG &conf) const
+	{
+		return Unroll<0>::InLimits(*this, conf) != 0;
+	}
+
+	/** It checks the joint velocities against their limits, without branches.
+	* @param vel : joint velocities
+	* @return  true if all the velocities are within the limits
+	*/
+	bool InVelocity(const MAST_CONFIG &vel) const
+	{
+		return Unroll<0>::InVelocity(*this, vel) != 0;
+	}
+
+	/** It computes the end effector position in the mast root coordination (forward kinematics).
+	* @param conf : mast configuration
+	* @param *ppos : scoop coordination
+	*/
+	void Forward(const MAST_CONFIG &conf, END_EFFECTOR_POS *ppos) const
+	{
+		double r = 0, z = Geometry::link(0), phi = 0;
+		Unroll<1>::Forward(conf, &r, &z, &phi);
+		ppos->x = r * cos(conf.joint[0]);
+		ppos->y = r * sin(conf.joint[0]);
+		ppos->z = z;
+		ppos->theta = phi;
+	}
+
+	double pos_min[joints]; /**< Minimum position of each joint, in radius */
+	double pos_max[joints]; /**< Maximum position of each joint, in radius */
+	double vel_max[joints]; /**< Maximum velocity of each joint, in radius/second */
+	double acc_max[joints]; /**< Maximum acceleration of each joint, in radius/second2 */
+
+private:
+	template <int I, bool End = (I >= joints)>
+	struct Unroll
+	{
+		static int InLimits(const MastModel &m, const MAST_CONFIG &conf)
+		{
+			return (conf.joint[I] >= m.pos_min[I]) & (conf.joint[I] <= m.pos_max[I]) & Unroll<I + 1>::InLimits(m, conf);
+		}
+
+		static int InVelocity(const MastModel &m, const MAST_CONFIG &vel)
+		{
+			return (vel.joint[I] >= -m.vel_max[I]) & (vel.joint[I] <= m.vel_max[I]) & Unroll<I + 1>::InVelocity(m, vel);
+		}
+
+		static void Forward(const MAST_CONFIG &conf, double *pr, double *pz, double *pphi)
+		{
+			*pphi += conf.joint[I];
+			*pr += Geometry::link(I) * cos(*pphi);
+			*pz += Geometry::link(I) * sin(*pphi);
+			Unroll<I + 1>::Forward(conf, pr, pz, pphi);
+		}
+	};
+
+	template <int I>
+	struct Unroll<I, true>
+	{
+		static int InLimits(const MastModel &, const MAST_CONFIG &) { return 1; }
+		static int InVelocity(const MastModel &, const MAST_CONFIG &) { return 1; }
+		static void Forward(const MAST_CONFIG &, double *, double *, double *) {}
+	};
+};
+
+
+/** Joint model of the Robotic Mast */
+
+typedef MastModel<MAST_GEOMETRY> MAST_MODEL;
+
+
+/** It sets a joint value, with the Joint ID checked at compile time.
+
+* @param value : Joint  value.
+
+* @return  Code of the first error encountered, otherwise OK 
+*/
+template <int ID>
+STATUS Mast_SetJointValue(double value)
+{
+	static_assert(MAST_MODEL::ValidJoint(ID), "Invalid Joint ID");
+	return Mast_SetJointValue(ID, value);
+}
+
+/** It return the joint value, with the Joint ID checked at compile time.
+
+* @param *pvalue : Joint  value.
+
+* @return  Code of the first error encountered, otherwise OK 
+*/
+template <int ID>
+STATUS Mast_GetJointValue(double *pvalue)
+{
+	static_assert(MAST_MODEL::ValidJoint(ID), "Invalid Joint ID");
+	return Mast_GetJointValue(ID, pvalue);
+}
+
+/*! @} */
@@ -0,0 +1,136 @@
+/*! \addtogroup Mission
+* This module provides the mission planner of the Decision Level. It translates a queue of mission goals into scripts of the Executive Control Level, batches them and schedules them.
+* The mission planner does not call the Functional Level modules directly: the scripts are compiled and run by the Executive module.
+*
+* Each goal is broken into operations (e.g. a retrieval goal gives a mast motion, Mast_SampleRetrieve(), Mast_SampleVerify() and Mast_SampleDump();
+* a survey goal gives mast motions in SCAN mode and CaptureSequence() at each view). The views of a survey goal are the centers of a grid which covers
+* its area with the spacing of the goal; at each view the mast points the IR Camera at the center of the view, then CaptureSequence() captures the steps of the goal.
+* Each operation uses resources (the mast, the IR Camera) and depends on other operations; a capture uses the IR Camera and the mast, since the mast should stay still.
+* The schedule is ordered to minimize the makespan of all the goals, and it is generated as an executive script:
+* each state runs one batch of operations, and the operations which do not use the same resource and do not depend on each other are put in a
+* \b parallel group (e.g. the move of the filter wheel to the first filter of the next survey view by SetFilter() while the mast dumps a sample).
+* The script is compiled by Exec_Compile() and run by Exec_Run().
+*
+* When Mast_SampleVerify() fails, the script goes to a replanning state, which is a final state, and Exec_Run() returns. Only the operations of the concerning goal
+* and the ones which depend on them are planned again (a retry is inserted, or the goal fails after its maximum number of attempts). The states of these operations
+* are generated again and replaced in the compiled script by Exec_ReplaceStates(); the other states are kept, and Mission_Run() runs the script again from the replanned state.
+*
+* - Mission_AddGoal(MISSION_GOAL goal, int *pgoal)
+* - Mission_Plan(MISSION_PLAN *pplan)
+* - Mission_Run(MISSION_PLAN *pplan)
+* - Mission_Replan(int goal, MISSION_PLAN *pplan)
+*  @{
+*/
+
+
+/** Maximum number of capture steps of a survey goal, one per IR filter */
+#define MISSION_STEPS 8
+
+
+/** MISSION_GOAL_TYPE
+
+* It defines the type of a mission goal.
+*/
+
+enum MISSION_GOAL_TYPE{
+	GOAL_SURVEY, /**< Survey an area with the IR Camera */
+	GOAL_RETRIEVE /**< Retrieve a sample at a point and dump it in a bin */
+	
+}; 
+
+
+/** MISSION_GOAL_STATE
+
+* It defines the state of a mission goal.
+*/
+
+enum MISSION_GOAL_STATE{
+	GOAL_PENDING, /**< The goal is not started */
+	GOAL_RUNNING, /**< The operations of the goal are running */
+	GOAL_DONE, /**< The goal is finished successfully */
+	GOAL_FAILED /**< The goal failed */
+	
+}; 
+
+
+/** Mission Goal
+
+* It defines one goal of the mission. The coordinations are defined in the robot coordination.
+*/
+
+typedef struct 
+{
+	enum MISSION_GOAL_TYPE type ; /**< Type of the goal */ 
+	double x ; /**< Sample coordination, or center of the area, along x axis */ 
+	double y ; /**< Sample coordination, or center of the area, along y axis */ 
+	double z ; /**< Sample coordination, or center of the area, along z axis */ 
+	double width ; /**< Width of the area (GOAL_SURVEY), in meter */ 
+	double length ; /**< Length of the area (GOAL_SURVEY), in meter */ 
+	double spacing ; /**< Distance between the centers of two neighbouring views (GOAL_SURVEY), in meter */ 
+	CAPTURE_STEP steps[MISSION_STEPS] ; /**< Capture steps of CaptureSequence() at each view (GOAL_SURVEY) */ 
+	int step_number ; /**< Number of capture steps, between 1 and MISSION_STEPS (GOAL_SURVEY) */ 
+	int binID ; /**< Bin ID (GOAL_RETRIEVE) */ 
+	int attempts ; /**< Maximum number of retrieval attempts (GOAL_RETRIEVE) */ 
+	int priority ; /**< Priority, a goal with a higher priority is scheduled first when they compete for a resource */ 
+} MISSION_GOAL;
+
+
+/** Mission Plan
+
+* It includes the summary of the current schedule.
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< OK or NOT_OK  */ 
+	int goals ; /**< Number of goals in the schedule */ 
+	int operations ; /**< Number of operations in the schedule */ 
+	int script ; /**< Script ID of the generated executive script */ 
+	int replanned ; /**< Number of operations planned again by the last replanning */ 
+	double makespan ; /**< Estimated duration of the schedule, in second */ 
+	double serial ; /**< Estimated duration if all the operations ran one after the other, in second */ 
+} MISSION_PLAN;
+
+
+
+/** It adds a goal to the queue of the mission.
+* @param goal : mission goal
+* @param *pgoal : goal ID
+* @return  Code of the first error encountered (e.g. the sample or the bin is not reachable, the spacing is not positive, wrong number of capture steps), otherwise OK 
+*/
+STATUS Mission_AddGoal(MISSION_GOAL goal, int *pgoal);
+
+/** It removes a goal from the queue of the mission. Its operations which are not started are removed from the schedule.
+* @param goal : goal ID
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mission_RemoveGoal(int goal);
+
+/** It breaks the goals into operations, computes the schedule and generates the executive script. Nothing moves.
+* @param *pplan : mission plan
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mission_Plan(MISSION_PLAN *pplan);
+
+/** It runs the executive script of the schedule by Exec_Run() until all the goals are finished or failed. The failed verifications are replanned by Mission_Replan().
+* @param *pplan : mission plan at the end of the run
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mission_Run(MISSION_PLAN *pplan);
+
+/** It plans again the operations of a goal and the ones which depend on them, and replaces their states in the executive script by Exec_ReplaceStates(). The rest of the schedule is kept.
+* @param goal : goal ID
+* @param *pplan : mission plan
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Mission_Replan(int goal, MISSION_PLAN *pplan);
+
+/** It returns the state of a goal.
+* @param goal : goal ID
+* @param *pstate : state of the goal
+* @param *perror : code of the error which failed the goal (GOAL_FAILED), otherwise OK
+* @return  Code of the first error encountered (e.g. unknown goal), otherwise OK 
+*/
+STATUS Mission_GetGoalState(int goal, enum MISSION_GOAL_STATE *pstate, STATUS *perror);
+
+/*! @} */
@@ -0,0 +1,109 @@
+/*! \addtogroup Session
+* This module provides the concurrent access of several users (executive scripts, teleoperation, telemetry) to the Mast module.
+*
+* Each user opens a session and binds it to its threads by Session_Bind(). The access is arbitrated as follows:
+*
+* - \b Queries (Mast_Get* functions): any number of sessions can call them concurrently. They read the state snapshot of the control loop without any lock,
+* so the telemetry readers never block the motion.
+* - \b Motion \b commands: they are accepted only from the session which holds the motion lease. The lease is granted by the arbiter for a limited duration
+* and should be renewed; if it expires (e.g. the owner script is blocked), another session can acquire it. Without the lease, a motion command of a bound session returns an error.
+* - \b Halts (Mast_HaltJoint(), Mast_HaltAllJoints()): any session can call them. They preempt the running motion and revoke the current lease.
+*
+* A thread which has no bound session (SESSION_DEFAULT) uses its own implicit session: a SESSION_OPERATOR session which the Mast module opens for the thread
+* at its first motion command and closes when the thread exits. Two unbound threads have different implicit sessions, so they are arbitrated as two users.
+* A motion command of an implicit session acquires the lease implicitly, waiting while another session holds it, and releases it when the motion is finished:
+* at the return for a blocking command, and at the end of the motion (not at the return) for an asynchronous command (Mast_*Async()).
+* The Mast_Turn* functions return before the motion, so their lease is kept until the teleoperation target has been reached (see Mast_GetTeleopTarget()),
+* and renewed by each merged increment; an increment from another session waits for it. So a single user which never calls the Session functions works as before.
+*
+* The functions which run a sequence of motions (Startup_Run(), Exec_Run(), Mast_RunCampaign(), Mission_Run(), Journal_Replay() and Sim_Benchmark())
+* acquire the lease for the session of the calling thread (bound or implicit) at their start, waiting while another session holds it,
+* renew it while they run, and release it at the end; their motions are not interleaved with the motions of another session.
+* If the lease is revoked by a halt, they stop and return an error.
+*
+* - Session_Open(enum SESSION_ROLE role, int *psession)
+* - Session_Bind(int session)
+* - Session_AcquireLease(int session, int duration, int timeout)
+* - Session_RenewLease(int session, int duration)
+* - Session_ReleaseLease(int session)
+*  @{
+*/
+
+
+/** Session ID of the threads which have no bound session, each of them uses its own implicit session */
+#define SESSION_DEFAULT 0
+
+
+/** SESSION_ROLE
+
+* It defines the role of a session.
+*/
+
+enum SESSION_ROLE{
+	SESSION_READER, /**< Queries only */
+	SESSION_OPERATOR /**< Queries and motion commands (with the lease) */
+	
+}; 
+
+
+/** Lease Information
+
+* It describes the current motion lease.
+*/
+
+typedef struct 
+{
+	int session ; /**< Session which holds the lease (the ID of the implicit session of a thread for an implicit lease), -1 if there is none */ 
+	unsigned long generation ; /**< It increases each time the lease is granted or revoked */ 
+	double expires ; /**< Time left before the lease expires, in ms */ 
+} LEASE_INFO;
+
+
+
+/** It opens a session.
+* @param role : SESSION_ROLE
+* @param *psession : session ID
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Session_Open(enum SESSION_ROLE role, int *psession);
+
+/** It closes a session and releases its lease.
+* @param session : session ID
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Session_Close(int session);
+
+/** It binds a session to the calling thread. The Mast functions called by the thread are arbitrated for this session.
+* @param session : session ID, SESSION_DEFAULT to go back to the implicit session of the thread
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Session_Bind(int session);
+
+/** It acquires the motion lease.
+* @param session : session ID, it should be a SESSION_OPERATOR session
+* @param duration : duration of the lease, in ms
+* @param timeout : Timeout in ms, 0 to return immediately, -1 to wait without timeout
+* @return  OK if the lease is granted, otherwise error code (e.g. timeout)
+*/
+STATUS Session_AcquireLease(int session, int duration, int timeout);
+
+/** It extends the motion lease held by a session.
+* @param session : session ID
+* @param duration : new duration of the lease from now, in ms
+* @return  Code of the first error encountered (e.g. the lease has expired or has been revoked), otherwise OK 
+*/
+STATUS Session_RenewLease(int session, int duration);
+
+/** It releases the motion lease held by a session. The running motion is finished.
+* @param session : session ID
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Session_ReleaseLease(int session);
+
+/** It returns the current motion lease. It does not block.
+* @param *pinfo : lease information
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Session_GetLease(LEASE_INFO *pinfo);
+
+/*! @} */
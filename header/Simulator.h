@@ -0,0 +1,104 @@
+/*! \addtogroup Simulator
+* This module provides the backend interface of the Mast and the IR Camera modules, and a deterministic simulated backend to use them without hardware.
+*
+* The Mast and the IR Camera modules do not access the hardware directly; they call a backend (MAST_BACKEND and CAMERA_BACKEND).
+* The hardware backends are used by default. The simulated backends are selected by Sim_Init():
+*
+* - \b Simulated \b mast: the joints follow the setpoints of the control loop with the dynamics limited by JOINT_PARA (vel_max, acc_max, curr_max).
+* The mode transitions follow MAST_MODE (locked in NAVIGATION and STOWAGE), and the scoop gets a sample when it scoops at a position which contains one.
+* The bin positions are the ones set by Mast_SetBinPos().
+* - \b Synthetic \b IR \b camera: it renders the scene with a noise which depends on the exposure and the filter, so SetExposure(), SetFilter() and SetAverage() change the images as they do on the camera.
+*
+* The simulation is deterministic: the same seed and the same commands give the same results. It runs faster than real time when the time scale is 0.
+* Sim_Benchmark() runs full Mast_SampleRetrieve() and Mast_SampleDump() cycles on the simulator, so the planner, the IK and the image pipeline can be regression tested on a Linux computer.
+*
+* - Sim_Init(unsigned int seed, double time_scale)
+* - Sim_AddSample(double x, double y, double z)
+* - Sim_Benchmark(int cycles, SIM_BENCH *preport)
+*  @{
+*/
+
+
+/** Mast Backend
+
+* It defines the functions used by the Mast module to access the joints.
+*/
+
+typedef struct 
+{
+	STATUS (*set_setpoint)(MAST_CONFIG conf); /**< It sends the setpoint of one control tick to the joints */ 
+	STATUS (*read_joints)(MAST_CONFIG *pconf, MAST_CONFIG *pvel, MAST_CONFIG *pcurr); /**< It reads the joint values, velocities and currents */ 
+	STATUS (*halt)(int jointID); /**< It halts a joint, -1 for all joints */ 
+	STATUS (*lock)(bool locked); /**< It locks or unlocks the mast */ 
+	STATUS (*scoop)(bool close); /**< It closes (scoop) or opens (drop) the scoop */ 
+} MAST_BACKEND;
+
+
+/** Camera Backend
+
+* It defines the functions used by the IR Camera module to access the camera.
+*/
+
+typedef struct 
+{
+	STATUS (*power)(bool on); /**< It turns the camera on or off */ 
+	STATUS (*move_filter)(int filter_id); /**< It starts the move of the filter wheel */ 
+	STATUS (*wait_filter)(); /**< It waits for the end of the move of the filter wheel */ 
+	STATUS (*get_size)(int *pwidth, int *pheight); /**< It returns the frame size of the camera, in pixel */ 
+	STATUS (*expose)(int exposure, int width, int height, unsigned short *pixels); /**< It takes one frame and writes it in pixels (width x height values, row by row); it returns error if the size is not the frame size */ 
+} CAMERA_BACKEND;
+
+
+/** Simulator Benchmark Report
+
+* It includes the result of Sim_Benchmark().
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< OK or NOT_OK  */ 
+	int cycles ; /**< Number of retrieve and dump cycles */ 
+	int retrieved ; /**< Number of verified sample retrievals */ 
+	double simulated_time ; /**< Mean simulated duration of a cycle, in second */ 
+	double wall_time ; /**< Mean wall clock duration of a cycle, in ms */ 
+	double speedup ; /**< simulated_time / wall_time */ 
+} SIM_BENCH;
+
+
+
+/** It sets the backend of the Mast module. It should be called before the initialization of the Mast module.
+* @param *pbackend : mast backend
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Sim_SetMastBackend(const MAST_BACKEND *pbackend);
+
+/** It sets the backend of the IR Camera module. It should be called before TurnOn().
+* @param *pbackend : camera backend
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Sim_SetCameraBackend(const CAMERA_BACKEND *pbackend);
+
+/** It starts the simulator and selects the simulated backends of the Mast and the IR Camera modules.
+* @param seed : seed of the random generators (noise, sample positions)
+* @param time_scale : 1 for real time, 0 to run as fast as possible
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Sim_Init(unsigned int seed, double time_scale);
+
+/** It puts a sample in the simulated scene. The location is defined in the robot local coordination.
+* @param x : sample coordination
+* @param y : sample coordination
+* @param z : sample coordination
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Sim_AddSample(double x, double y, double z);
+
+/** It runs retrieve and dump cycles on the simulator. Each cycle calls Mast_SampleRetrieve() on a sample of the scene and Mast_SampleDump() to the next bin.
+Note: Sim_Init(), and the initialization of the Mast module, should be done before.
+* @param cycles : number of cycles
+* @param *preport : benchmark report
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Sim_Benchmark(int cycles, SIM_BENCH *preport);
+
+/*! @} */
@@ -0,0 +1,119 @@
+/*! \addtogroup Startup
+* This module provides the startup sequence of the Functional Level, after the Off Mode or the Sleep Mode.
+*
+* The startup steps are the initialization of the IR Camera (TurnOn(), RunTest()) and of the Mast (Mast_SetMastRootPosition(), Mast_SetBinPos(), Mast_SetJointPara() for each joint,
+* Mast_SetControlRate() and Mast_StartControlLoop(), Mast_BuildModeTable(), Mast_SelfTest()). Startup_Run() builds the dependency graph of these steps
+* and runs the independent ones concurrently (e.g. the camera bring-up alongside the mast initialization).
+*
+* The dependencies are fixed (see STARTUP_STEP and Startup_GetDepends()):
+*
+* - Camera: STEP_TURN_ON, then STEP_RUN_TEST.
+* - Mast: STEP_ROOT_POSITION, then STEP_BIN_POS, then STEP_JOINT_PARA, then STEP_CONTROL_LOOP, then STEP_MODE_TABLE, then STEP_SELF_TEST.
+* The Mast steps run one after the other, in the order of the initialization of the Mast module: the configuration functions (Mast_SetMastRootPosition(),
+* Mast_SetBinPos(), Mast_SetJointPara() and Mast_SetControlRate()) are accepted before the root position and a bin position are set, and the other Mast functions
+* return an error until both are set. The control loop uses the joint parameters, and the mode table uses the root position and the joint parameters.
+*
+* The two chains are independent, so the critical path is the longer of them.
+*
+* The validated configuration (joint parameters, kinematic chain, IK cache and mode transition table) is kept in a cache file.
+* In a warm restart, if the configuration has not changed, it is loaded from the cache instead of being computed again.
+* The report gives the start and the duration of each step, and the steps on the critical path.
+*
+* - Startup_Run(STARTUP_CONFIG config, STARTUP_REPORT *preport)
+* - Startup_ClearCache(string path)
+*  @{
+*/
+
+
+/** STARTUP_STEP
+
+* It defines the startup steps.
+*/
+
+enum STARTUP_STEP{
+	STEP_TURN_ON, /**< TurnOn() */
+	STEP_RUN_TEST, /**< RunTest(), after STEP_TURN_ON */
+	STEP_ROOT_POSITION, /**< Mast_SetMastRootPosition(), first Mast step */
+	STEP_BIN_POS, /**< Mast_SetBinPos() for each bin, after STEP_ROOT_POSITION */
+	STEP_JOINT_PARA, /**< Mast_SetJointPara() for each joint, after STEP_BIN_POS */
+	STEP_CONTROL_LOOP, /**< Mast_SetControlRate() and Mast_StartControlLoop(), after STEP_JOINT_PARA */
+	STEP_MODE_TABLE, /**< Mast_BuildModeTable(), after STEP_CONTROL_LOOP */
+	STEP_SELF_TEST, /**< Mast_SelfTest(), after STEP_MODE_TABLE */
+	STEP_NUMBER /**< Number of steps */
+	
+}; 
+
+
+/** Startup Bin
+
+* It defines the position of a sample bin.
+*/
+
+typedef struct 
+{
+	int binID ; /**< Bin ID */ 
+	double x ; /**< Coordination along x axis  */ 
+	double y ; /**< Coordination along y axis  */ 
+	double z ; /**< Coordination along z axis  */ 
+} STARTUP_BIN;
+
+
+/** Startup Configuration
+
+* It includes the arguments of all the startup steps.
+*/
+
+typedef struct 
+{
+	JOINT_PARA *joint_para ; /**< Joint parameters, indexed by Joint ID */ 
+	int joints ; /**< Number of joints */ 
+	STARTUP_BIN *bins ; /**< Bin positions */ 
+	int bins_number ; /**< Number of bins */ 
+	double root[6] ; /**< Mast root position: x, y, z, roll, pitch and yaw */ 
+	double control_rate ; /**< Control rate in Hz, for Mast_SetControlRate() */ 
+	int setpoints ; /**< Size of the setpoint buffers, for Mast_SetControlRate() */ 
+	int control_cpu ; /**< CPU of the control thread, for Mast_StartControlLoop() */ 
+	int control_priority ; /**< SCHED_FIFO priority of the control thread, for Mast_StartControlLoop() */ 
+	string cache ; /**< Path of the cache file, empty string to disable the cache */ 
+} STARTUP_CONFIG;
+
+
+/** Startup Report
+
+* It includes the result and the timing of each startup step, in ms from the call of Startup_Run().
+*/
+
+typedef struct 
+{
+	STATUS status ; /**< OK or the code of the first error encountered  */ 
+	STATUS step_status[STEP_NUMBER] ; /**< STATUS of each step */ 
+	double step_start[STEP_NUMBER] ; /**< Start of each step */ 
+	double step_duration[STEP_NUMBER] ; /**< Duration of each step */ 
+	bool critical[STEP_NUMBER] ; /**< true if the step is on the critical path */ 
+	bool warm ; /**< true if the configuration was loaded from the cache */ 
+	double duration ; /**< Time to the first command, in ms */ 
+} STARTUP_REPORT;
+
+
+
+/** It runs the startup steps, concurrently when they are independent. A step starts when all the steps it depends on are finished with OK.
+* @param config : startup configuration
+* @param *preport : startup report
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Startup_Run(STARTUP_CONFIG config, STARTUP_REPORT *preport);
+
+/** It returns the steps a startup step depends on.
+* @param step : STARTUP_STEP
+* @param *pmask : bit mask of the steps, bit i is set if the step depends on the STARTUP_STEP i
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Startup_GetDepends(enum STARTUP_STEP step, unsigned int *pmask);
+
+/** It deletes the cache file, so the next startup is a cold one.
+* @param path : Path of the cache file
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Startup_ClearCache(string path);
+
+/*! @} */
@@ -0,0 +1,75 @@
+/*! \addtogroup Stats
+* This module provides the timing instrumentation of the Mast and the IR Camera modules.
+*
+* Each instrumented point records its latency in an HDR histogram (high dynamic range, 3 significant digits). The timestamps are read from the TSC of the processor,
+* and each thread records in its own histograms without any lock, so the instrumentation costs a few nanoseconds per call.
+* The histograms of all the threads are merged when a snapshot is taken.
+*
+* The instrumented points are:
+*
+* - every public function of the Mast and the IR Camera modules, named by the function (e.g. "Mast_SampleRetrieve", "Capture");
+* - the internal stages, named "stage.ik", "stage.planning", "stage.bus", "stage.capture", "stage.save" and "stage.verify".
+*
+* The snapshots can be read by Stats_GetSnapshot(), exported as JSON by Stats_Export(), or read from a local HTTP endpoint started by Stats_StartEndpoint().
+* So it is possible to find which step exceeds the time budget of a retrieval cycle.
+* Mast_GetReport() does not include the snapshots: it has no length parameter, and the snapshots should be read by Stats_Export().
+*
+* - Stats_Enable(bool enable)
+* - Stats_GetSnapshot(string point, STATS_SNAPSHOT *psnap)
+* - Stats_Export(string *pjson)
+* - Stats_StartEndpoint(int port)
+*  @{
+*/
+
+
+/** Stats Snapshot
+
+* It includes the statistics of one instrumented point since the last Stats_Reset(), in microsecond.
+*/
+
+typedef struct 
+{
+	unsigned long count ; /**< Number of calls */ 
+	unsigned long errors ; /**< Number of calls which did not return OK */ 
+	double min ; /**< Minimum latency */ 
+	double mean ; /**< Mean latency */ 
+	double p50 ; /**< Median latency */ 
+	double p90 ; /**< 90th percentile latency */ 
+	double p99 ; /**< 99th percentile latency */ 
+	double p999 ; /**< 99.9th percentile latency */ 
+	double max ; /**< Maximum latency */ 
+} STATS_SNAPSHOT;
+
+
+
+/** It enables or disables the instrumentation. It is enabled by default.
+* @param enable : true to enable
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Stats_Enable(bool enable);
+
+/** It clears the histograms of all the points.
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Stats_Reset();
+
+/** It returns the snapshot of one instrumented point.
+* @param point : name of the point
+* @param *psnap : snapshot
+* @return  Code of the first error encountered (e.g. unknown point), otherwise OK 
+*/
+STATUS Stats_GetSnapshot(string point, STATS_SNAPSHOT *psnap);
+
+/** It returns the snapshots of all the points as a JSON object, indexed by the name of the point.
+* @param *pjson : JSON object
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Stats_Export(string *pjson);
+
+/** It starts a local HTTP endpoint which returns Stats_Export() on "/stats". It listens on the loopback interface only.
+* @param port : TCP port, 0 to stop the endpoint
+* @return  Code of the first error encountered, otherwise OK 
+*/
+STATUS Stats_StartEndpoint(int port);
+
+/*! @} */
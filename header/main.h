@@ -17,18 +17,18 @@
 * \subsection subsec1 Functional Level
 * All the main processing algorithms will be developed at this level in a modular fashion. Each module provides us with a number of functions (Requests) to communicate with the module.  Each module can receive some predefined Requests and can return a Report at the end of processing the Request. Each Request contains a Command and an array of arguments as the input to the associated algorithm. Each Report contains a success flag (OK or Not_OK) and an array of return arguments. 
 *
-* The required modules are presented in the Module Page.
+* The Requests and Reports are dispatched by the Bus module. The required modules are presented in the Module Page.
 *
 * \subsection subsec2 Executive Control Level
 * This level contains several scripts to call the Requests of the Functional Level Modules.  The robot is supposed to be controlled based on the state machine approach. This level consists of the required scripts to transit between states or keeps the robot in a specific state.
 * The executive level has access to all the presented functions and calls to execute any task. 
 *
-* The Executive level is currently under development.
+* The scripts are loaded, compiled and run by the Executive module.
 *
 * \subsection subsec3 Decision Level
 * Decision level translates the high level requests of users or a mission planner to a command to call one or several scripts of Executive Level. Based on the user request, a piece of script will be selected at this level and will be run to call the Requests of the Functional Level.  
 * 
-* The Decision level is currently under development.
+* The mission goals are translated into executive scripts, which are batched and scheduled by the Mission module and run by the Executive module.
 *
 *
 * \section sec3 Housekeeping
@@ -45,6 +45,8 @@
 * -	Temperature Report
 * -	Power report
 * -	(To be defined)
+*
+* The power and temperature reports are used by the Housekeeping module to schedule the Mast and IR Camera workloads.
 
 
 